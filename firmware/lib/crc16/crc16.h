@@ -0,0 +1,66 @@
+/*
+*  CRC-16 implementation
+*/
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include <stdint.h>
+
+// CRC16 version
+#define CRC16_VERSION 1.0.0
+
+// Uncomment to offload large CRC-16/CCITT buffers to the ADuCM4050 CRC
+// accelerator. Requires the CRC driver component in the RTE configuration.
+//#define CRC16_HW_ENABLE
+
+// Minimum buffer size to offload to the CRC accelerator
+#define CRC16_HW_MIN_LENGTH 32 // bytes
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Calculate a CRC-16/CCITT (polynomial 0x1021, MSB first) over a buffer
+// Parameters:
+//   crc: Initial CRC value (preload, or result of a previous call)
+//   data: Data to checksum
+//   length: Size of the data, in bytes
+// Returns: The updated CRC value
+uint16_t crc16_ccitt(uint16_t crc, const uint8_t *data, uint32_t length);
+
+// Calculate a CRC-16/X.25 (polynomial 0x1021 reflected, LSB first) over a buffer
+// Parameters:
+//   crc: Initial CRC value (preload, or result of a previous call)
+//   data: Data to checksum
+//   length: Size of the data, in bytes
+// Returns: The updated CRC value
+uint16_t crc16_x25(uint16_t crc, const uint8_t *data, uint32_t length);
+
+// Add a single byte to a CRC-16/X.25
+// Parameters:
+//   crc: Current CRC value
+//   b: Byte to add
+// Returns: The updated CRC value
+uint16_t crc16_x25Byte(uint16_t crc, uint8_t b);
+
+// Check the CRC implementations against known results
+// Returns: 1 if all checks pass, 0 otherwise
+uint8_t crc16_selfTest();
+
+#if defined(CRC16_HW_ENABLE)
+// Calculate a CRC-16/CCITT over a buffer using the CRC accelerator
+// Parameters:
+//   crc: Initial CRC value
+//   data: Data to checksum
+//   length: Size of the data, in bytes
+// Returns: The updated CRC value
+// Notes: Implemented by the platform
+uint16_t crc16_hwCcitt(uint16_t crc, const uint8_t *data, uint32_t length);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRC16_H_
@@ -31,9 +31,14 @@ static inline unsigned hashset_hash(void *key, int len) {
 	return h;
 }
 
+// Gets a hashset entry, the item followed by its value
+static inline uint8_t* getEntry(hashset* h, uint16_t index) {
+	return h->table + (index * (h->itemSize + h->valueSize));
+}
+
 // Checks whether an item matches an entry in the hashset
 static inline int8_t isEqual(hashset* h, uint16_t index, uint8_t* item) {
-	uint8_t *p = h->table + (index * h->itemSize);
+	uint8_t *p = getEntry(h, index);
 	for (uint16_t i = 0; i < h->itemSize; ++i) {
 		if (*p++ != *item++) {
 			return 0;
@@ -45,10 +50,13 @@ static inline int8_t isEqual(hashset* h, uint16_t index, uint8_t* item) {
 // Sets a hashset item
 static inline void setItem(hashset* h, uint16_t index, uint8_t* item) {
 	h->tableIndex[index / 8] |= 1 << (index % 8);
-	uint8_t *p = h->table + (index * h->itemSize);
+	uint8_t *p = getEntry(h, index);
 	for (uint16_t i = 0; i < h->itemSize; ++i) {
 		*p++ = *item++;
 	}
+	for (uint16_t i = 0; i < h->valueSize; ++i) {
+		*p++ = 0;
+	}
 }
 
 // Initialise a hashset
@@ -57,11 +65,22 @@ static inline void setItem(hashset* h, uint16_t index, uint8_t* item) {
 //   tableSize: Maximum number of items to store
 //   itemSize: Size of each item, in bytes
 void hashset_init(hashset *h, uint16_t tableSize, uint16_t itemSize) {
+	hashset_initValues(h, tableSize, itemSize, 0);
+}
+
+// Initialise a hashset with a value stored alongside each item
+// Parameters:
+//   h: Pointer to a hashset
+//   tableSize: Maximum number of items to store
+//   itemSize: Size of each item, in bytes
+//   valueSize: Size of the value stored with each item, in bytes
+void hashset_initValues(hashset *h, uint16_t tableSize, uint16_t itemSize, uint16_t valueSize) {
 	h->itemSize = itemSize;
+	h->valueSize = valueSize;
 	h->tableSize = tableSize;
 	h->length = 0;
 
-	h->table = (uint8_t*)malloc(tableSize * itemSize * sizeof(uint8_t));
+	h->table = (uint8_t*)malloc(tableSize * (itemSize + valueSize) * sizeof(uint8_t));
 	h->tableIndex = tableSize % 8 == 0 
 		? (uint8_t*)calloc(tableSize / 8, sizeof(uint8_t))
 		: (uint8_t*)calloc((tableSize / 8) + 1, sizeof(uint8_t));
@@ -83,6 +102,19 @@ void hashset_destroy(hashset *h) {
 //          HASHSET_ITEM_EXISTS if duplicate item found,
 //          HASHSET_TABLE_FULL: if the hashset is full
 uint8_t hashset_add(hashset* h, uint8_t* item) {
+	uint8_t *value;
+	return hashset_addValue(h, item, &value);
+}
+
+// Add an item to the hashset and get its value
+// Parameters:
+//   h: Pointer to hashset to add to
+//   item: The item data to add
+//   value: Set to the value stored with the item, unless the hashset is full
+// Returns: HASHSET_OK on success,
+//          HASHSET_ITEM_EXISTS if duplicate item found,
+//          HASHSET_TABLE_FULL: if the hashset is full
+uint8_t hashset_addValue(hashset* h, uint8_t* item, uint8_t** value) {
 	if (h->length >= h->tableSize) {
 		// Table full, escape quickly
 		return 2;
@@ -97,9 +129,11 @@ uint8_t hashset_add(hashset* h, uint8_t* item) {
 			// Slot is free, add
 			setItem(h, index, item);
 			++h->length;
+			*value = getEntry(h, index) + h->itemSize;
 			return 0;
 		} else if (isEqual(h, index, item)) {
 			// Item already exists
+			*value = getEntry(h, index) + h->itemSize;
 			return 1;
 		}
 		index = (index + 1) % h->tableSize;
@@ -109,6 +143,30 @@ uint8_t hashset_add(hashset* h, uint8_t* item) {
 	return 2;
 }
 
+// Find an item in the hashset and get its value
+// Parameters:
+//   h: Pointer to hashset to search
+//   item: The item data to find
+//   value: Set to the value stored with the item, if found
+// Returns: 1 if the item was found, 0 otherwise
+uint8_t hashset_findValue(hashset* h, uint8_t* item, uint8_t** value) {
+	uint16_t i;
+	uint16_t index = hashset_hash(item, h->itemSize) % h->tableSize;
+
+	// Linear probe up to the first free slot
+	for (i = 0; i < h->tableSize; ++i) {
+		if (isSlotFree(h, index)) {
+			return 0;
+		} else if (isEqual(h, index, item)) {
+			*value = getEntry(h, index) + h->itemSize;
+			return 1;
+		}
+		index = (index + 1) % h->tableSize;
+	}
+
+	return 0;
+}
+
 // Initialise an iterator over the unique items in a hashset
 // Parameters:
 //   h: Pointer to the hashset to iterate
@@ -117,6 +175,7 @@ void hashset_initIterator(hashset* h, hashset_iterator* it) {
 	it->h = h;
 	it->index = 0;
 	it->item = 0;
+	it->value = 0;
 }
 
 // Iterate to the next unique item
@@ -125,6 +184,7 @@ void hashset_initIterator(hashset* h, hashset_iterator* it) {
 // Returns: 0 if no items left, 1 if successful
 uint8_t hashset_iterate(hashset_iterator* it) {
 	it->item = 0;
+	it->value = 0;
 	if (it->index > it->h->tableSize) {
 		return 0;
 	}
@@ -134,7 +194,8 @@ uint8_t hashset_iterate(hashset_iterator* it) {
 			return 0;
 		}
 	}
-	it->item = it->h->table + (it->index * it->h->itemSize);
+	it->item = getEntry(it->h, it->index);
+	it->value = it->item + it->h->itemSize;
 	++it->index;
 	return 1;
 }
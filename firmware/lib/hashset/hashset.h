@@ -8,7 +8,7 @@
 #include <stdint.h>
 
 // Hashset version
-#define HASHSET_VERSION 1.0.0
+#define HASHSET_VERSION 1.2.0
 
 // Hashset result codes
 #define HASHSET_OK 0
@@ -22,6 +22,7 @@ extern "C" {
 // Hashset
 typedef struct _hashset {
 	uint16_t itemSize;
+	uint16_t valueSize;
 	uint16_t tableSize;
 	uint16_t length;
 	uint8_t *table;
@@ -33,6 +34,7 @@ typedef struct _hashset_iterator {
 	hashset *h;
 	uint16_t index;
 	uint8_t *item;
+	uint8_t *value;
 } hashset_iterator;
 
 // Initialise a hashset
@@ -42,6 +44,16 @@ typedef struct _hashset_iterator {
 //   itemSize: Size of each item, in bytes
 void hashset_init(hashset* h, uint16_t tableSize, uint16_t itemSize);
 
+// Initialise a hashset with a value stored alongside each item
+// Parameters:
+//   h: Pointer to a hashset
+//   tableSize: Maximum number of items to store
+//   itemSize: Size of each item, in bytes
+//   valueSize: Size of the value stored with each item, in bytes
+// Notes: Values are not part of the item, they are not compared and are set
+// to zero when the item is added
+void hashset_initValues(hashset* h, uint16_t tableSize, uint16_t itemSize, uint16_t valueSize);
+
 // Add an item to the hashset
 // Parameters:
 //   h: Pointer to hashset to add to
@@ -51,6 +63,24 @@ void hashset_init(hashset* h, uint16_t tableSize, uint16_t itemSize);
 //          HASHSET_TABLE_FULL: if the hashset is full
 uint8_t hashset_add(hashset* h, uint8_t* item);
 
+// Add an item to the hashset and get its value
+// Parameters:
+//   h: Pointer to hashset to add to
+//   item: The item data to add
+//   value: Set to the value stored with the item, unless the hashset is full
+// Returns: HASHSET_OK on success,
+//          HASHSET_ITEM_EXISTS if duplicate item found,
+//          HASHSET_TABLE_FULL: if the hashset is full
+uint8_t hashset_addValue(hashset* h, uint8_t* item, uint8_t** value);
+
+// Find an item in the hashset and get its value
+// Parameters:
+//   h: Pointer to hashset to search
+//   item: The item data to find
+//   value: Set to the value stored with the item, if found
+// Returns: 1 if the item was found, 0 otherwise
+uint8_t hashset_findValue(hashset* h, uint8_t* item, uint8_t** value);
+
 // Empties all items from a hashset
 // Parameters:
 //    h: Pointer to hashset to empty
@@ -35,13 +35,27 @@ static const pb_decoder_t PB_DECODERS[PB_LTYPES_COUNT] = {
  * pb_istream *
  **************/
 
+static bool checkreturn buf_read(pb_istream_t *stream, uint8_t *buf, size_t count);
+
 bool checkreturn pb_read(pb_istream_t *stream, uint8_t *buf, size_t count)
 {
     if (stream->bytes_left < count)
         return false;
 
-    if (!stream->callback(stream, buf, count))
+    if (stream->callback == &buf_read)
+    {
+        /* Memory buffer stream, copy directly */
+        uint8_t *source = (uint8_t*)stream->state;
+
+        if (buf != NULL)
+            memcpy(buf, source, count);
+
+        stream->state = source + count;
+    }
+    else if (!stream->callback(stream, buf, count))
+    {
         return false;
+    }
 
     stream->bytes_left -= count;
     return true;
@@ -85,6 +99,41 @@ bool checkreturn pb_decode_varint(pb_istream_t *stream, uint64_t *dest)
     uint8_t bitpos = 0;
     *dest = 0;
 
+    if (stream->callback == &buf_read)
+    {
+        /* Memory buffer stream, decode in place. Consumes the same bytes as
+         * the generic loop below, including on failure. */
+        const uint8_t *source = (const uint8_t*)stream->state;
+        size_t limit = (stream->bytes_left < 10) ? stream->bytes_left : 10;
+        size_t i = 0;
+        bool status = false;
+
+        if (limit && !(source[0] & 0x80))
+        {
+            *dest = source[0];
+            stream->state = (uint8_t*)source + 1;
+            stream->bytes_left--;
+            return true;
+        }
+
+        while (i < limit)
+        {
+            byte = source[i];
+            *dest |= (uint64_t)(byte & 0x7F) << (7 * i);
+            i++;
+
+            if (!(byte & 0x80))
+            {
+                status = true;
+                break;
+            }
+        }
+
+        stream->state = (uint8_t*)source + i;
+        stream->bytes_left -= i;
+        return status;
+    }
+
     while (bitpos < 64 && pb_read(stream, &byte, 1))
     {
         *dest |= (uint64_t)(byte & 0x7F) << bitpos;
@@ -100,6 +149,29 @@ bool checkreturn pb_decode_varint(pb_istream_t *stream, uint64_t *dest)
 bool checkreturn pb_skip_varint(pb_istream_t *stream)
 {
     uint8_t byte;
+
+    if (stream->callback == &buf_read)
+    {
+        /* Memory buffer stream, scan in place */
+        const uint8_t *source = (const uint8_t*)stream->state;
+        size_t i = 0;
+
+        do
+        {
+            if (i >= stream->bytes_left)
+            {
+                stream->state = (uint8_t*)source + i;
+                stream->bytes_left = 0;
+                return false;
+            }
+            byte = source[i++];
+        } while (byte & 0x80);
+
+        stream->state = (uint8_t*)source + i;
+        stream->bytes_left -= i;
+        return true;
+    }
+
     do
     {
         if (!pb_read(stream, &byte, 1))
@@ -54,7 +54,18 @@ pb_ostream_t pb_ostream_from_buffer(uint8_t *buf, size_t bufsize)
 
 bool checkreturn pb_write(pb_ostream_t *stream, const uint8_t *buf, size_t count)
 {
-    if (stream->callback != NULL)
+    if (stream->callback == &buf_write)
+    {
+        /* Memory buffer stream, copy directly */
+        uint8_t *dest = (uint8_t*)stream->state;
+
+        if (stream->bytes_written + count > stream->max_size)
+            return false;
+
+        memcpy(dest, buf, count);
+        stream->state = dest + count;
+    }
+    else if (stream->callback != NULL)
     {
         if (stream->bytes_written + count > stream->max_size)
             return false;
@@ -207,6 +218,24 @@ bool checkreturn pb_encode_varint(pb_ostream_t *stream, uint64_t value)
     uint8_t buffer[10];
     int i = 0;
 
+    if (stream->callback == &buf_write
+        && stream->max_size - stream->bytes_written >= sizeof(buffer))
+    {
+        /* Memory buffer stream with room for any varint, encode in place */
+        uint8_t *dest = (uint8_t*)stream->state;
+
+        while (value > 0x7F)
+        {
+            dest[i++] = (uint8_t)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        dest[i++] = (uint8_t)value;
+
+        stream->state = dest + i;
+        stream->bytes_written += i;
+        return true;
+    }
+
     if (value == 0)
         return pb_write(stream, (uint8_t*)&value, 1);
 
@@ -41,6 +41,8 @@ typedef uint32_t ipj_handler_type;
 #define E_IPJ_HANDLER_TYPE_DIAGNOSTIC ((uint32_t)(0x7))
 #define E_IPJ_HANDLER_TYPE_PLATFORM_MODIFY_CONNECTION ((uint32_t)(0x8))
 #define E_IPJ_HANDLER_TYPE_PLATFORM_FLUSH_PORT ((uint32_t)(0x9))
+#define E_IPJ_HANDLER_TYPE_TAG_REPORT ((uint32_t)(0xA))
+#define E_IPJ_HANDLER_TYPE_COMMAND_COMPLETE ((uint32_t)(0xB))
 
 typedef uint32_t ipj_idle_power_mode;
 #define E_IPJ_IDLE_POWER_MODE_STANDARD ((uint32_t)(0x0))
@@ -0,0 +1,1975 @@
+/* Automatically generated by tools/pb_fastgen.py from messages.pb.c, do not edit */
+#include "messages_fast.h"
+
+static int64_t pb_fast_unzigzag(uint64_t value)
+{
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+static bool pb_fast_open_substream(pb_istream_t *stream, pb_istream_t *substream)
+{
+    uint64_t size;
+
+    if (!pb_decode_varint(stream, &size) || size > stream->bytes_left)
+    {
+        return false;
+    }
+
+    *substream = *stream;
+    substream->bytes_left = (size_t) size;
+    stream->bytes_left -= (size_t) size;
+    return true;
+}
+
+static size_t pb_fast_varint_size(uint64_t value)
+{
+    size_t size = 1;
+
+    while (value > 0x7F)
+    {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static void BulkSetResponse_clear_fast(BulkSetResponse *dest)
+{
+    dest->has_error = false;
+    dest->error = BulkSetResponse_error_default;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool BulkSetResponse_decode_fast(pb_istream_t *stream, BulkSetResponse *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    BulkSetResponse_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(BulkSetResponse, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(BulkSetResponse, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void KeyValue_clear_fast(KeyValue *dest)
+{
+    dest->has_key = false;
+    dest->key = 0;
+    dest->has_value = false;
+    dest->value = 0;
+    dest->has_bank_index = false;
+    dest->bank_index = 0;
+    dest->has_value_index = false;
+    dest->value_index = 0;
+}
+
+bool KeyValue_decode_fast(pb_istream_t *stream, KeyValue *dest)
+{
+    uint64_t key;
+    uint64_t value;
+
+    KeyValue_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_key = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->key = (ipj_key) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_value = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->value = (uint32_t) value;
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_bank_index = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->bank_index = (uint32_t) value;
+                break;
+
+            case (4 << 3) | PB_WT_VARINT:
+                dest->has_value_index = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->value_index = (uint32_t) value;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 4:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void KeyList_clear_fast(KeyList *dest)
+{
+    dest->has_key = false;
+    dest->key = 0;
+    dest->list_count = 0;
+    dest->has_bank_index = false;
+    dest->bank_index = 0;
+    dest->has_value_index = false;
+    dest->value_index = 0;
+    dest->has_length = false;
+    dest->length = 0;
+}
+
+bool KeyList_decode_fast(pb_istream_t *stream, KeyList *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    KeyList_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_key = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->key = (ipj_key) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                if (dest->list_count >= pb_arraysize(KeyList, list))
+                {
+                    return false;
+                }
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->list[dest->list_count++] = (uint32_t) value;
+                break;
+
+            case (2 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->list_count < pb_arraysize(KeyList, list))
+                {
+                    if (!pb_decode_varint(&substream, &value))
+                    {
+                        return false;
+                    }
+                    dest->list[dest->list_count] = (uint32_t) value;
+                    dest->list_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_bank_index = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->bank_index = (uint32_t) value;
+                break;
+
+            case (4 << 3) | PB_WT_VARINT:
+                dest->has_value_index = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->value_index = (uint32_t) value;
+                break;
+
+            case (5 << 3) | PB_WT_VARINT:
+                dest->has_length = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->length = (uint32_t) value;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 4:
+                    case 5:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void BulkGetResponse_clear_fast(BulkGetResponse *dest)
+{
+    dest->has_error = false;
+    dest->error = BulkGetResponse_error_default;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->key_value_count = 0;
+    dest->key_list_count = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool BulkGetResponse_decode_fast(pb_istream_t *stream, BulkGetResponse *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    BulkGetResponse_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (4 << 3) | PB_WT_STRING:
+                if (dest->key_value_count >= pb_arraysize(BulkGetResponse, key_value))
+                {
+                    return false;
+                }
+                if (!pb_fast_open_substream(stream, &substream)
+                        || !KeyValue_decode_fast(&substream, &dest->key_value[dest->key_value_count++]))
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            case (5 << 3) | PB_WT_STRING:
+                if (dest->key_list_count >= pb_arraysize(BulkGetResponse, key_list))
+                {
+                    return false;
+                }
+                if (!pb_fast_open_substream(stream, &substream)
+                        || !KeyList_decode_fast(&substream, &dest->key_list[dest->key_list_count++]))
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(BulkGetResponse, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(BulkGetResponse, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 4:
+                    case 5:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void StartResponse_clear_fast(StartResponse *dest)
+{
+    dest->has_error = false;
+    dest->error = StartResponse_error_default;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool StartResponse_decode_fast(pb_istream_t *stream, StartResponse *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    StartResponse_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(StartResponse, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(StartResponse, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void ResumeResponse_clear_fast(ResumeResponse *dest)
+{
+    dest->has_error = false;
+    dest->error = ResumeResponse_error_default;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+}
+
+bool ResumeResponse_decode_fast(pb_istream_t *stream, ResumeResponse *dest)
+{
+    uint64_t key;
+    uint64_t value;
+
+    ResumeResponse_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void StopResponse_clear_fast(StopResponse *dest)
+{
+    dest->has_error = false;
+    dest->error = StopResponse_error_default;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool StopResponse_decode_fast(pb_istream_t *stream, StopResponse *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    StopResponse_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(StopResponse, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(StopResponse, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void Tag_clear_fast(Tag *dest)
+{
+    dest->has_epc = false;
+    dest->epc.size = 0;
+    dest->has_tid = false;
+    dest->tid.size = 0;
+    dest->has_pc = false;
+    dest->pc = 0;
+    dest->has_xpc = false;
+    dest->xpc = 0;
+    dest->has_crc = false;
+    dest->crc = 0;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->has_rssi = false;
+    dest->rssi = 0;
+    dest->has_phase = false;
+    dest->phase = 0;
+    dest->has_channel = false;
+    dest->channel = 0;
+    dest->has_antenna = false;
+    dest->antenna = 0;
+}
+
+bool Tag_decode_fast(pb_istream_t *stream, Tag *dest)
+{
+    uint64_t key;
+    uint64_t value;
+
+    Tag_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_STRING:
+                dest->has_epc = true;
+                if (!pb_decode_varint(stream, &value)
+                        || value > sizeof(dest->epc.bytes))
+                {
+                    return false;
+                }
+                dest->epc.size = (size_t) value;
+                if (!pb_read(stream, dest->epc.bytes, dest->epc.size))
+                {
+                    return false;
+                }
+                break;
+
+            case (2 << 3) | PB_WT_STRING:
+                dest->has_tid = true;
+                if (!pb_decode_varint(stream, &value)
+                        || value > sizeof(dest->tid.bytes))
+                {
+                    return false;
+                }
+                dest->tid.size = (size_t) value;
+                if (!pb_read(stream, dest->tid.bytes, dest->tid.size))
+                {
+                    return false;
+                }
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_pc = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->pc = (uint32_t) value;
+                break;
+
+            case (4 << 3) | PB_WT_VARINT:
+                dest->has_xpc = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->xpc = (uint32_t) value;
+                break;
+
+            case (5 << 3) | PB_WT_VARINT:
+                dest->has_crc = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->crc = (uint32_t) value;
+                break;
+
+            case (6 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (7 << 3) | PB_WT_VARINT:
+                dest->has_rssi = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->rssi = (int32_t) pb_fast_unzigzag(value);
+                break;
+
+            case (8 << 3) | PB_WT_VARINT:
+                dest->has_phase = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->phase = (int32_t) pb_fast_unzigzag(value);
+                break;
+
+            case (9 << 3) | PB_WT_VARINT:
+                dest->has_channel = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->channel = (uint32_t) value;
+                break;
+
+            case (10 << 3) | PB_WT_VARINT:
+                dest->has_antenna = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->antenna = (uint32_t) value;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 4:
+                    case 5:
+                    case 6:
+                    case 7:
+                    case 8:
+                    case 9:
+                    case 10:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void TagOperationReport_clear_fast(TagOperationReport *dest)
+{
+    dest->has_error = false;
+    dest->error = TagOperationReport_error_default;
+    dest->has_tag = false;
+    Tag_clear_fast(&dest->tag);
+    dest->has_tag_operation_type = false;
+    dest->tag_operation_type = 0;
+    dest->has_tag_operation_data = false;
+    dest->tag_operation_data.size = 0;
+    dest->has_retries = false;
+    dest->retries = TagOperationReport_retries_default;
+    dest->has_diagnostic = false;
+    dest->diagnostic = 0;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool TagOperationReport_decode_fast(pb_istream_t *stream, TagOperationReport *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    TagOperationReport_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_STRING:
+                dest->has_tag = true;
+                if (!pb_fast_open_substream(stream, &substream)
+                        || !Tag_decode_fast(&substream, &dest->tag))
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_tag_operation_type = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->tag_operation_type = (ipj_tag_operation_type) value;
+                break;
+
+            case (4 << 3) | PB_WT_STRING:
+                dest->has_tag_operation_data = true;
+                if (!pb_decode_varint(stream, &value)
+                        || value > sizeof(dest->tag_operation_data.bytes))
+                {
+                    return false;
+                }
+                dest->tag_operation_data.size = (size_t) value;
+                if (!pb_read(stream, dest->tag_operation_data.bytes, dest->tag_operation_data.size))
+                {
+                    return false;
+                }
+                break;
+
+            case (5 << 3) | PB_WT_VARINT:
+                dest->has_retries = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->retries = (uint32_t) value;
+                break;
+
+            case (6 << 3) | PB_WT_VARINT:
+                dest->has_diagnostic = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->diagnostic = (uint32_t) value;
+                break;
+
+            case (7 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(TagOperationReport, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(TagOperationReport, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 4:
+                    case 5:
+                    case 6:
+                    case 7:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void StopReport_clear_fast(StopReport *dest)
+{
+    dest->has_error = false;
+    dest->error = StopReport_error_default;
+    dest->has_action = false;
+    dest->action = 0;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool StopReport_decode_fast(pb_istream_t *stream, StopReport *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    StopReport_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_action = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->action = (ipj_action) value;
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(StopReport, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(StopReport, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void StatusReport_clear_fast(StatusReport *dest)
+{
+    dest->has_status_flag = false;
+    dest->status_flag = 0;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->has_status_1 = false;
+    dest->status_1 = 0;
+    dest->has_status_2 = false;
+    dest->status_2 = 0;
+    dest->has_status_3 = false;
+    dest->status_3 = 0;
+    dest->data_count = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool StatusReport_decode_fast(pb_istream_t *stream, StatusReport *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    StatusReport_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_status_flag = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->status_flag = (ipj_status_flag) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_status_1 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->status_1 = (uint32_t) value;
+                break;
+
+            case (4 << 3) | PB_WT_VARINT:
+                dest->has_status_2 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->status_2 = (uint32_t) value;
+                break;
+
+            case (5 << 3) | PB_WT_VARINT:
+                dest->has_status_3 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->status_3 = (uint32_t) value;
+                break;
+
+            case (6 << 3) | PB_WT_VARINT:
+                if (dest->data_count >= pb_arraysize(StatusReport, data))
+                {
+                    return false;
+                }
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->data[dest->data_count++] = (uint32_t) value;
+                break;
+
+            case (6 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->data_count < pb_arraysize(StatusReport, data))
+                {
+                    if (!pb_decode_varint(&substream, &value))
+                    {
+                        return false;
+                    }
+                    dest->data[dest->data_count] = (uint32_t) value;
+                    dest->data_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(StatusReport, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(StatusReport, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 4:
+                    case 5:
+                    case 6:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static void ErrorReport_clear_fast(ErrorReport *dest)
+{
+    dest->has_error = false;
+    dest->error = ErrorReport_error_default;
+    dest->has_param1 = false;
+    dest->param1 = 0;
+    dest->has_param2 = false;
+    dest->param2 = 0;
+    dest->has_param3 = false;
+    dest->param3 = 0;
+    dest->has_param4 = false;
+    dest->param4 = 0;
+    dest->has_timestamp = false;
+    dest->timestamp = 0;
+    dest->lt_buffer_count = 0;
+}
+
+bool ErrorReport_decode_fast(pb_istream_t *stream, ErrorReport *dest)
+{
+    uint64_t key;
+    uint64_t value;
+    pb_istream_t substream;
+
+    ErrorReport_clear_fast(dest);
+
+    while (stream->bytes_left)
+    {
+        if (!pb_decode_varint(stream, &key))
+        {
+            return false;
+        }
+        if (key == 0)
+        {
+            /* Zero terminated message */
+            break;
+        }
+
+        switch (key)
+        {
+            case (1 << 3) | PB_WT_VARINT:
+                dest->has_error = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->error = (ipj_error) value;
+                break;
+
+            case (2 << 3) | PB_WT_VARINT:
+                dest->has_param1 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->param1 = (uint32_t) value;
+                break;
+
+            case (3 << 3) | PB_WT_VARINT:
+                dest->has_param2 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->param2 = (uint32_t) value;
+                break;
+
+            case (4 << 3) | PB_WT_VARINT:
+                dest->has_param3 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->param3 = (uint32_t) value;
+                break;
+
+            case (5 << 3) | PB_WT_VARINT:
+                dest->has_param4 = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->param4 = (uint32_t) value;
+                break;
+
+            case (6 << 3) | PB_WT_VARINT:
+                dest->has_timestamp = true;
+                if (!pb_decode_varint(stream, &value))
+                {
+                    return false;
+                }
+                dest->timestamp = (uint64_t) value;
+                break;
+
+            case (15 << 3) | PB_WT_32BIT:
+                if (dest->lt_buffer_count >= pb_arraysize(ErrorReport, lt_buffer))
+                {
+                    return false;
+                }
+                if (!pb_dec_fixed32(stream, NULL, &dest->lt_buffer[dest->lt_buffer_count++]))
+                {
+                    return false;
+                }
+                break;
+
+            case (15 << 3) | PB_WT_STRING:
+                if (!pb_fast_open_substream(stream, &substream))
+                {
+                    return false;
+                }
+                while (substream.bytes_left
+                        && dest->lt_buffer_count < pb_arraysize(ErrorReport, lt_buffer))
+                {
+                    if (!pb_dec_fixed32(&substream, NULL, &dest->lt_buffer[dest->lt_buffer_count]))
+                    {
+                        return false;
+                    }
+                    dest->lt_buffer_count++;
+                }
+                if (substream.bytes_left)
+                {
+                    return false;
+                }
+                stream->state = substream.state;
+                break;
+
+            default:
+                /* Known fields on any other wire type are left to pb_decode() */
+                switch (key >> 3)
+                {
+                    case 1:
+                    case 2:
+                    case 3:
+                    case 4:
+                    case 5:
+                    case 6:
+                    case 15:
+                        return false;
+                    default:
+                        break;
+                }
+                if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+
+    return true;
+}
+
+static size_t KeyValue_size_fast(const KeyValue *src)
+{
+    size_t size = 0;
+
+    if (src->has_key)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->key);
+    }
+    if (src->has_value)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->value);
+    }
+    if (src->has_bank_index)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->bank_index);
+    }
+    if (src->has_value_index)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->value_index);
+    }
+
+    return size;
+}
+
+bool KeyValue_encode_fast(pb_ostream_t *stream, const KeyValue *src)
+{
+    if (src->has_key)
+    {
+        if (!pb_encode_varint(stream, (1 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->key))
+        {
+            return false;
+        }
+    }
+    if (src->has_value)
+    {
+        if (!pb_encode_varint(stream, (2 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->value))
+        {
+            return false;
+        }
+    }
+    if (src->has_bank_index)
+    {
+        if (!pb_encode_varint(stream, (3 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->bank_index))
+        {
+            return false;
+        }
+    }
+    if (src->has_value_index)
+    {
+        if (!pb_encode_varint(stream, (4 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->value_index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static size_t KeyList_size_fast(const KeyList *src)
+{
+    size_t size = 0;
+    size_t payload;
+    size_t i;
+
+    if (src->has_key)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->key);
+    }
+    if (src->list_count)
+    {
+        payload = 0;
+        for (i = 0; i < src->list_count; i++)
+        {
+            payload += pb_fast_varint_size((uint32_t) src->list[i]);
+        }
+        size += 1 + pb_fast_varint_size(payload) + payload;
+    }
+    if (src->has_bank_index)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->bank_index);
+    }
+    if (src->has_value_index)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->value_index);
+    }
+    if (src->has_length)
+    {
+        size += 1 + pb_fast_varint_size((uint32_t) src->length);
+    }
+
+    return size;
+}
+
+bool KeyList_encode_fast(pb_ostream_t *stream, const KeyList *src)
+{
+    size_t payload;
+    size_t i;
+
+    if (src->has_key)
+    {
+        if (!pb_encode_varint(stream, (1 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->key))
+        {
+            return false;
+        }
+    }
+    if (src->list_count)
+    {
+        payload = 0;
+        for (i = 0; i < src->list_count; i++)
+        {
+            payload += pb_fast_varint_size((uint32_t) src->list[i]);
+        }
+        if (!pb_encode_varint(stream, (2 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, payload))
+        {
+            return false;
+        }
+        for (i = 0; i < src->list_count; i++)
+        {
+            if (!pb_encode_varint(stream, (uint32_t) src->list[i]))
+            {
+                return false;
+            }
+        }
+    }
+    if (src->has_bank_index)
+    {
+        if (!pb_encode_varint(stream, (3 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->bank_index))
+        {
+            return false;
+        }
+    }
+    if (src->has_value_index)
+    {
+        if (!pb_encode_varint(stream, (4 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->value_index))
+        {
+            return false;
+        }
+    }
+    if (src->has_length)
+    {
+        if (!pb_encode_varint(stream, (5 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->length))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BulkSetCommand_encode_fast(pb_ostream_t *stream, const BulkSetCommand *src)
+{
+    size_t payload;
+    size_t i;
+
+    for (i = 0; i < src->key_value_count; i++)
+    {
+        if (!pb_encode_varint(stream, (4 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, KeyValue_size_fast(&src->key_value[i]))
+                || !KeyValue_encode_fast(stream, &src->key_value[i]))
+        {
+            return false;
+        }
+    }
+    for (i = 0; i < src->key_list_count; i++)
+    {
+        if (!pb_encode_varint(stream, (5 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, KeyList_size_fast(&src->key_list[i]))
+                || !KeyList_encode_fast(stream, &src->key_list[i]))
+        {
+            return false;
+        }
+    }
+    if (src->lt_buffer_count)
+    {
+        payload = 4 * src->lt_buffer_count;
+        if (!pb_encode_varint(stream, (15 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, payload))
+        {
+            return false;
+        }
+        for (i = 0; i < src->lt_buffer_count; i++)
+        {
+            if (!pb_encode_fixed32(stream, &src->lt_buffer[i]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool BulkGetCommand_encode_fast(pb_ostream_t *stream, const BulkGetCommand *src)
+{
+    size_t payload;
+    size_t i;
+
+    for (i = 0; i < src->key_value_count; i++)
+    {
+        if (!pb_encode_varint(stream, (4 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, KeyValue_size_fast(&src->key_value[i]))
+                || !KeyValue_encode_fast(stream, &src->key_value[i]))
+        {
+            return false;
+        }
+    }
+    for (i = 0; i < src->key_list_count; i++)
+    {
+        if (!pb_encode_varint(stream, (5 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, KeyList_size_fast(&src->key_list[i]))
+                || !KeyList_encode_fast(stream, &src->key_list[i]))
+        {
+            return false;
+        }
+    }
+    if (src->lt_buffer_count)
+    {
+        payload = 4 * src->lt_buffer_count;
+        if (!pb_encode_varint(stream, (15 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, payload))
+        {
+            return false;
+        }
+        for (i = 0; i < src->lt_buffer_count; i++)
+        {
+            if (!pb_encode_fixed32(stream, &src->lt_buffer[i]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool StartCommand_encode_fast(pb_ostream_t *stream, const StartCommand *src)
+{
+    size_t payload;
+    size_t i;
+
+    if (src->has_action)
+    {
+        if (!pb_encode_varint(stream, (1 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->action))
+        {
+            return false;
+        }
+    }
+    if (src->lt_buffer_count)
+    {
+        payload = 4 * src->lt_buffer_count;
+        if (!pb_encode_varint(stream, (15 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, payload))
+        {
+            return false;
+        }
+        for (i = 0; i < src->lt_buffer_count; i++)
+        {
+            if (!pb_encode_fixed32(stream, &src->lt_buffer[i]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ResumeCommand_encode_fast(pb_ostream_t *stream, const ResumeCommand *src)
+{
+    if (src->has_action)
+    {
+        if (!pb_encode_varint(stream, (1 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->action))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool StopCommand_encode_fast(pb_ostream_t *stream, const StopCommand *src)
+{
+    size_t payload;
+    size_t i;
+
+    if (src->has_action)
+    {
+        if (!pb_encode_varint(stream, (1 << 3) | PB_WT_VARINT)
+                || !pb_encode_varint(stream, (uint32_t) src->action))
+        {
+            return false;
+        }
+    }
+    if (src->lt_buffer_count)
+    {
+        payload = 4 * src->lt_buffer_count;
+        if (!pb_encode_varint(stream, (15 << 3) | PB_WT_STRING)
+                || !pb_encode_varint(stream, payload))
+        {
+            return false;
+        }
+        for (i = 0; i < src->lt_buffer_count; i++)
+        {
+            if (!pb_encode_fixed32(stream, &src->lt_buffer[i]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static bool BulkSetResponse_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return BulkSetResponse_decode_fast(stream, (BulkSetResponse*) dest);
+}
+
+static bool BulkGetResponse_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return BulkGetResponse_decode_fast(stream, (BulkGetResponse*) dest);
+}
+
+static bool StartResponse_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return StartResponse_decode_fast(stream, (StartResponse*) dest);
+}
+
+static bool ResumeResponse_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return ResumeResponse_decode_fast(stream, (ResumeResponse*) dest);
+}
+
+static bool StopResponse_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return StopResponse_decode_fast(stream, (StopResponse*) dest);
+}
+
+static bool TagOperationReport_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return TagOperationReport_decode_fast(stream, (TagOperationReport*) dest);
+}
+
+static bool StopReport_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return StopReport_decode_fast(stream, (StopReport*) dest);
+}
+
+static bool StatusReport_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return StatusReport_decode_fast(stream, (StatusReport*) dest);
+}
+
+static bool ErrorReport_decode_erased(pb_istream_t *stream, void *dest)
+{
+    return ErrorReport_decode_fast(stream, (ErrorReport*) dest);
+}
+
+static bool BulkSetCommand_encode_erased(pb_ostream_t *stream, const void *src)
+{
+    return BulkSetCommand_encode_fast(stream, (const BulkSetCommand*) src);
+}
+
+static bool BulkGetCommand_encode_erased(pb_ostream_t *stream, const void *src)
+{
+    return BulkGetCommand_encode_fast(stream, (const BulkGetCommand*) src);
+}
+
+static bool StartCommand_encode_erased(pb_ostream_t *stream, const void *src)
+{
+    return StartCommand_encode_fast(stream, (const StartCommand*) src);
+}
+
+static bool ResumeCommand_encode_erased(pb_ostream_t *stream, const void *src)
+{
+    return ResumeCommand_encode_fast(stream, (const ResumeCommand*) src);
+}
+
+static bool StopCommand_encode_erased(pb_ostream_t *stream, const void *src)
+{
+    return StopCommand_encode_fast(stream, (const StopCommand*) src);
+}
+
+static const pb_fast_codec_t pb_fast_codecs[] =
+{
+    { BulkSetResponse_fields, BulkSetResponse_decode_erased, NULL },
+    { BulkGetResponse_fields, BulkGetResponse_decode_erased, NULL },
+    { StartResponse_fields, StartResponse_decode_erased, NULL },
+    { ResumeResponse_fields, ResumeResponse_decode_erased, NULL },
+    { StopResponse_fields, StopResponse_decode_erased, NULL },
+    { TagOperationReport_fields, TagOperationReport_decode_erased, NULL },
+    { StopReport_fields, StopReport_decode_erased, NULL },
+    { StatusReport_fields, StatusReport_decode_erased, NULL },
+    { ErrorReport_fields, ErrorReport_decode_erased, NULL },
+    { BulkSetCommand_fields, NULL, BulkSetCommand_encode_erased },
+    { BulkGetCommand_fields, NULL, BulkGetCommand_encode_erased },
+    { StartCommand_fields, NULL, StartCommand_encode_erased },
+    { ResumeCommand_fields, NULL, ResumeCommand_encode_erased },
+    { StopCommand_fields, NULL, StopCommand_encode_erased },
+};
+
+const pb_fast_codec_t* pb_fast_find_codec(const pb_field_t fields[])
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(pb_fast_codecs) / sizeof(pb_fast_codecs[0]); i++)
+    {
+        if (pb_fast_codecs[i].fields == fields)
+        {
+            return &pb_fast_codecs[i];
+        }
+    }
+    return NULL;
+}
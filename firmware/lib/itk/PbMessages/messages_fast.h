@@ -0,0 +1,45 @@
+/* Automatically generated by tools/pb_fastgen.py from messages.pb.c, do not edit */
+#ifndef _PB_MESSAGES_FAST_PB_H_
+#define _PB_MESSAGES_FAST_PB_H_
+#include <pb_decode.h>
+#include <pb_encode.h>
+#include "messages.pb.h"
+
+/* Type erased codec for a message field table */
+typedef bool (*pb_fast_decoder_t)(pb_istream_t *stream, void *dest);
+typedef bool (*pb_fast_encoder_t)(pb_ostream_t *stream, const void *src);
+
+typedef struct
+{
+    const pb_field_t  *fields;
+    pb_fast_decoder_t  decode;
+    pb_fast_encoder_t  encode;
+} pb_fast_codec_t;
+
+/* Specialised decoders. Return false where pb_decode() should be used instead. */
+bool BulkSetResponse_decode_fast(pb_istream_t *stream, BulkSetResponse *dest);
+bool KeyValue_decode_fast(pb_istream_t *stream, KeyValue *dest);
+bool KeyList_decode_fast(pb_istream_t *stream, KeyList *dest);
+bool BulkGetResponse_decode_fast(pb_istream_t *stream, BulkGetResponse *dest);
+bool StartResponse_decode_fast(pb_istream_t *stream, StartResponse *dest);
+bool ResumeResponse_decode_fast(pb_istream_t *stream, ResumeResponse *dest);
+bool StopResponse_decode_fast(pb_istream_t *stream, StopResponse *dest);
+bool Tag_decode_fast(pb_istream_t *stream, Tag *dest);
+bool TagOperationReport_decode_fast(pb_istream_t *stream, TagOperationReport *dest);
+bool StopReport_decode_fast(pb_istream_t *stream, StopReport *dest);
+bool StatusReport_decode_fast(pb_istream_t *stream, StatusReport *dest);
+bool ErrorReport_decode_fast(pb_istream_t *stream, ErrorReport *dest);
+
+/* Specialised encoders */
+bool KeyValue_encode_fast(pb_ostream_t *stream, const KeyValue *src);
+bool KeyList_encode_fast(pb_ostream_t *stream, const KeyList *src);
+bool BulkSetCommand_encode_fast(pb_ostream_t *stream, const BulkSetCommand *src);
+bool BulkGetCommand_encode_fast(pb_ostream_t *stream, const BulkGetCommand *src);
+bool StartCommand_encode_fast(pb_ostream_t *stream, const StartCommand *src);
+bool ResumeCommand_encode_fast(pb_ostream_t *stream, const ResumeCommand *src);
+bool StopCommand_encode_fast(pb_ostream_t *stream, const StopCommand *src);
+
+/* Returns the codec for a message field table, or NULL if there is none */
+const pb_fast_codec_t* pb_fast_find_codec(const pb_field_t fields[]);
+
+#endif
@@ -21,7 +21,11 @@
 #include <pb_decode.h>
 #include <pb_encode.h>
 #include <packet.pb.h>
+#if defined(IPJ_FAST_PB_CODECS)
+#include <messages_fast.h>
+#endif
 #include <version.h>
+#include <crc16.h>
 
 #define IPJ_ENUMS
 #include "iri.h"
@@ -77,11 +81,22 @@ char const anIdentString[256] = IDENT_STRING;
 #define IPJ_FLAG_SUPPRESS_SET_RESPONSES  (1 << 2)
 #define IPJ_FLAG_EXTENDED_COMMAND_MASK   (1 << 0)
 
-/* Protobuf offsets */
+/* Protobuf offsets, room reserved in front of the encoded message for the
+ * packet and command layers */
 #define PB_PKT_SIZE                       8
 #define PB_CMD_SIZE                       8
 #define PB_MSG_SIZE                       MAX_TX_PAYLOAD_SIZE - PB_PKT_SIZE - PB_CMD_SIZE
 
+/* Field numbers used by the tag report fast path (see TagOperationReport_fields and Tag_fields) */
+#define PB_TAG_OPERATION_REPORT_ERROR     1
+#define PB_TAG_OPERATION_REPORT_TAG       2
+#define PB_TAG_OPERATION_REPORT_TYPE      3
+#define PB_TAG_OPERATION_REPORT_DATA      4
+#define PB_TAG_EPC                        1
+#define PB_TAG_TID                        2
+#define PB_TAG_RSSI                       7
+#define PB_TAG_ANTENNA                    10
+
 #define RETURN_ERROR_ON_INVALID_DEVICE()          \
 if (!iri_device || !iri_device->initialized)      \
 {                                                 \
@@ -124,6 +139,38 @@ typedef union _ipj_rr_union
     GPIOReport               gpio_rpt;
 } ipj_rr_union;
 
+/* Pre-encoded packet, command and message layers of the commands sent at
+ * every inventory cycle boundary. Transmitting one of these only needs the
+ * frame header, sync count, parity and CRC. */
+#define IPJ_FRAME_TEMPLATE_PAYLOAD_SIZE 6
+
+typedef struct
+{
+    const pb_field_t* cmd_field_desc;
+    ipj_action        action;
+    uint8_t           payload_length;
+    uint8_t           payload[IPJ_FRAME_TEMPLATE_PAYLOAD_SIZE];
+} ipj_frame_template;
+
+static const ipj_frame_template ipj_internal_frame_templates[] =
+{
+    /* Packet.command (3) { Command.start (7) { StartCommand.action (1) = INVENTORY } } */
+    { &Command_fields[COMMAND_FIELDS_INDEX_START], E_IPJ_ACTION_INVENTORY, 6,
+        { 0x1A, 0x04, 0x3A, 0x02, 0x08, 0x01 } },
+    /* Packet.command (3) { Command.stop (8) { StopCommand.action (1) = INVENTORY } } */
+    { &Command_fields[COMMAND_FIELDS_INDEX_STOP], E_IPJ_ACTION_INVENTORY, 6,
+        { 0x1A, 0x04, 0x42, 0x02, 0x08, 0x01 } },
+    /* Packet.command (3) { Command.resume (9) { ResumeCommand.action (1) = INVENTORY } } */
+    { &Command_fields[COMMAND_FIELDS_INDEX_RESUME], E_IPJ_ACTION_INVENTORY, 6,
+        { 0x1A, 0x04, 0x4A, 0x02, 0x08, 0x01 } },
+};
+
+/* Response/report decode area shared by ipj_receive and ipj_internal_transact.
+ * The decoded messages are large (BulkGetResponse is several hundred bytes),
+ * so they are kept off the stack and only initialised when a complete frame
+ * is about to be decoded. Contents are only valid until the next decode. */
+static ipj_rr_union ipj_internal_rr_union;
+
 typedef ipj_error (*ipj_internal_completion_handler)(
         ipj_rr_union *rr_union,
         void* args);
@@ -147,6 +194,18 @@ static ipj_error ipj_internal_transact(
         void* command,
         void* handler_args,
         ipj_internal_completion_handler handler);
+static ipj_error ipj_internal_transmit_async(
+        ipj_iri_device* iri_device,
+        const pb_field_t* cmd_field_desc,
+        void* command);
+static void ipj_internal_complete_command(ipj_iri_device* iri_device, ipj_error error);
+static void ipj_internal_check_command_timeout(ipj_iri_device* iri_device);
+static ipj_error ipj_internal_build_bulk_set(
+        BulkSetCommand* command,
+        ipj_key_value*  key_value,
+        uint32_t        key_value_count,
+        ipj_key_list*   key_list,
+        uint32_t        key_list_count);
 
 static void ipj_internal_reset_rx_state_machine(ipj_iri_device* iri_device);
 static ipj_error ipj_internal_receive(
@@ -249,6 +308,11 @@ ipj_error ipj_deinitialize_iri_device(ipj_iri_device* iri_device) /**< [in] IRI
  * error report,
  * and stop report
  *
+ * User application may also register a tag report handler, which receives
+ * the key fields of tag operation reports without a full report decode,
+ * and a command complete handler, which receives the result of
+ * asynchronous commands.
+ *
  * \return ipj_error
  */
 ipj_error ipj_register_handler_ext(
@@ -305,6 +369,14 @@ ipj_error ipj_register_handler_ext(
             iri_device->diagnostic_handler = (DIAGNOSTIC_HANDLER_EXT) handler;
             iri_device->diagnostic_args = args;
             break;
+        case E_IPJ_HANDLER_TYPE_TAG_REPORT:
+            iri_device->tag_report_handler = (TAG_REPORT_HANDLER_EXT) handler;
+            iri_device->tag_report_args = args;
+            break;
+        case E_IPJ_HANDLER_TYPE_COMMAND_COMPLETE:
+            iri_device->command_complete_handler = (COMMAND_COMPLETE_HANDLER_EXT) handler;
+            iri_device->command_complete_args = args;
+            break;
         case E_IPJ_HANDLER_TYPE_PLATFORM_MODIFY_CONNECTION:
             iri_device->platform_modify_connection_handler =
                     (PLATFORM_MODIFY_CONNECTION_HANDLER_EXT) handler;
@@ -435,6 +507,26 @@ static void compat_diagnostic_handler(
             error);
 }
 
+static ipj_error compat_tag_report_handler(
+        void* opaque_args,
+        struct ipj_iri_device* iri_device,
+        ipj_tag_report_view* tag_report)
+{
+    TAG_REPORT_HANDLER handler = (TAG_REPORT_HANDLER) opaque_args;
+    return handler(iri_device,
+                   tag_report);
+}
+
+static void compat_command_complete_handler(
+        void* opaque_args,
+        struct ipj_iri_device* iri_device,
+        ipj_error error)
+{
+    COMMAND_COMPLETE_HANDLER handler = (COMMAND_COMPLETE_HANDLER) opaque_args;
+    handler(iri_device,
+            error);
+}
+
 /**
  * This function registers platform and report handlers.
  * Before using an IRI device, the User application must do the following:
@@ -455,6 +547,11 @@ static void compat_diagnostic_handler(
  * error report,
  * and stop report
  *
+ * User application may also register a tag report handler, which receives
+ * the key fields of tag operation reports without a full report decode,
+ * and a command complete handler, which receives the result of
+ * asynchronous commands.
+ *
  * \return ipj_error
  */
 ipj_error ipj_register_handler(
@@ -498,6 +595,12 @@ ipj_error ipj_register_handler(
         case E_IPJ_HANDLER_TYPE_DIAGNOSTIC:
             compat_handler = (IPJ_VOID_PFN) compat_diagnostic_handler;
             break;
+        case E_IPJ_HANDLER_TYPE_TAG_REPORT:
+            compat_handler = (IPJ_VOID_PFN) compat_tag_report_handler;
+            break;
+        case E_IPJ_HANDLER_TYPE_COMMAND_COMPLETE:
+            compat_handler = (IPJ_VOID_PFN) compat_command_complete_handler;
+            break;
         case E_IPJ_HANDLER_TYPE_PLATFORM_MODIFY_CONNECTION:
             compat_handler = (IPJ_VOID_PFN) compat_platform_modify_connection_handler;
             break;
@@ -835,6 +938,96 @@ ipj_error ipj_stop(
             NULL);
 }
 
+/**
+ * This function starts the specified action or operation on the IRI device
+ * without waiting for the response. The result is passed to the command
+ * complete handler from ipj_receive once the response arrives.
+ *
+ * \return ipj_error
+ */
+ipj_error ipj_start_async(
+        ipj_iri_device* iri_device,     /**< [in] IRI device data structure */
+        ipj_action action)              /**< [in] Actions or operations to start */
+{
+    StartCommand command = {0};
+
+    RETURN_ERROR_ON_INVALID_DEVICE();
+
+    command.has_action = true;
+    command.action = action;
+
+    return ipj_internal_transmit_async(
+            iri_device,
+            &Command_fields[COMMAND_FIELDS_INDEX_START],
+            &command);
+}
+
+/**
+ * This function stops the specified action or operation on the IRI device
+ * without waiting for the response. The result is passed to the command
+ * complete handler from ipj_receive once the response arrives.
+ *
+ * \return ipj_error
+ */
+ipj_error ipj_stop_async(
+        ipj_iri_device* iri_device,     /**< [in] IRI device data structure */
+        ipj_action action)              /**< [in] Actions or operations to be stopped */
+{
+    StopCommand command = {0};
+
+    RETURN_ERROR_ON_INVALID_DEVICE();
+
+    command.has_action = true;
+    command.action = action;
+
+    return ipj_internal_transmit_async(
+            iri_device,
+            &Command_fields[COMMAND_FIELDS_INDEX_STOP],
+            &command);
+}
+
+/**
+ * This function waits for the outstanding asynchronous command, if any, to
+ * complete. Reports received while waiting are passed to their handlers and
+ * the command result is passed to the command complete handler.
+ *
+ * \return ipj_error
+ */
+ipj_error ipj_wait_command(ipj_iri_device* iri_device) /**< [in] IRI device data structure */
+{
+    ipj_error error;
+    uint32_t response_id;
+
+    RETURN_ERROR_ON_INVALID_DEVICE();
+
+    while (iri_device->pending_command_id)
+    {
+        ipj_internal_check_command_timeout(iri_device);
+        if (!iri_device->pending_command_id)
+        {
+            break;
+        }
+
+        error = ipj_internal_receive(iri_device, &ipj_internal_rr_union, &response_id);
+        if (error)
+        {
+            return error;
+        }
+    }
+
+    return E_IPJ_ERROR_SUCCESS;
+}
+
+/**
+ * This function returns whether an asynchronous command is waiting for its response.
+ *
+ * \return bool
+ */
+bool ipj_command_pending(ipj_iri_device* iri_device) /**< [in] IRI device data structure */
+{
+    return iri_device && iri_device->pending_command_id;
+}
+
 static ipj_error ipj_get_info_handler(ipj_rr_union *rr_union, void* args)
 {
     ipj_key_info * key_info = (ipj_key_info*) (args);
@@ -1088,11 +1281,75 @@ ipj_error ipj_bulk_set(
         ipj_key_list   *key_list,       /**< [in/out] Array of key codes to set (used for key codes with lists) */
         uint32_t        key_list_count) /**< [in] Number of keys codes (with lists) to set */
 {
-    uint32_t i;
+    ipj_error error;
     BulkSetCommand command = {0};
 
     RETURN_ERROR_ON_INVALID_DEVICE();
 
+    error = ipj_internal_build_bulk_set(
+            &command,
+            key_value,
+            key_value_count,
+            key_list,
+            key_list_count);
+    if (error)
+    {
+        return error;
+    }
+
+    return ipj_internal_transact(
+            iri_device,
+            &Command_fields[COMMAND_FIELDS_INDEX_BULK_SET],
+            &command,
+            NULL,
+            NULL);
+}
+
+/**
+ * This function sets the values of the given key codes without waiting for
+ * the response. The result is passed to the command complete handler from
+ * ipj_receive once the response arrives.
+ *
+ * \return ipj_error
+ */
+ipj_error ipj_bulk_set_async(
+        ipj_iri_device *iri_device,     /**< [in] IRI device data structure */
+        ipj_key_value  *key_value,      /**< [in/out] Array of key codes and values to set */
+        uint32_t        key_value_count,/**< [in] Number of key codes and values to set */
+        ipj_key_list   *key_list,       /**< [in/out] Array of key codes to set (used for key codes with lists) */
+        uint32_t        key_list_count) /**< [in] Number of keys codes (with lists) to set */
+{
+    ipj_error error;
+    BulkSetCommand command = {0};
+
+    RETURN_ERROR_ON_INVALID_DEVICE();
+
+    error = ipj_internal_build_bulk_set(
+            &command,
+            key_value,
+            key_value_count,
+            key_list,
+            key_list_count);
+    if (error)
+    {
+        return error;
+    }
+
+    return ipj_internal_transmit_async(
+            iri_device,
+            &Command_fields[COMMAND_FIELDS_INDEX_BULK_SET],
+            &command);
+}
+
+static ipj_error ipj_internal_build_bulk_set(
+        BulkSetCommand *command,
+        ipj_key_value  *key_value,
+        uint32_t        key_value_count,
+        ipj_key_list   *key_list,
+        uint32_t        key_list_count)
+{
+    uint32_t i;
+
     /*
      * Error if there is a count specified for an array but the array is NULL
      */
@@ -1104,8 +1361,8 @@ ipj_error ipj_bulk_set(
     /*
      * Error if the array sizes provided are out of range
      */
-    if (key_value_count > ARRAY_SIZE(command.key_value)
-            || key_list_count > ARRAY_SIZE(command.key_list))
+    if (key_value_count > ARRAY_SIZE(command->key_value)
+            || key_list_count > ARRAY_SIZE(command->key_list))
     {
         return E_IPJ_ERROR_API_INVALID_PARAMETER;
     }
@@ -1114,7 +1371,7 @@ ipj_error ipj_bulk_set(
      * Set BULK_SET command parameters
      */
 
-    command.key_value_count = key_value_count;
+    command->key_value_count = key_value_count;
     for (i = 0; i < key_value_count; i++)
     {
         key_value[i].has_key         = true;
@@ -1122,10 +1379,10 @@ ipj_error ipj_bulk_set(
         key_value[i].has_value       = true;
         key_value[i].has_value_index = true;
 
-        memcpy(&command.key_value[i], &key_value[i], sizeof(ipj_key_value));
+        memcpy(&command->key_value[i], &key_value[i], sizeof(ipj_key_value));
     }
 
-    command.key_list_count = key_list_count;
+    command->key_list_count = key_list_count;
     for (i = 0; i < key_list_count; i++)
     {
         key_list[i].has_key         = true;
@@ -1133,15 +1390,10 @@ ipj_error ipj_bulk_set(
         key_list[i].has_length      = false;
         key_list[i].has_value_index = true;
 
-        memcpy(&command.key_list[i], &key_list[i], sizeof(ipj_key_list));
+        memcpy(&command->key_list[i], &key_list[i], sizeof(ipj_key_list));
     }
 
-    return ipj_internal_transact(
-            iri_device,
-            &Command_fields[COMMAND_FIELDS_INDEX_BULK_SET],
-            &command,
-            NULL,
-            NULL);
+    return E_IPJ_ERROR_SUCCESS;
 }
 
 static ipj_error ipj_reset_handler(ipj_rr_union *rr_union, void* args)
@@ -1200,8 +1452,74 @@ ipj_error ipj_reset(
 ipj_error ipj_receive(ipj_iri_device* iri_device) /**< [in] IRI device data structure */
 {
     uint32_t response_id;
-    ipj_rr_union rr_union = {{0}};
-    return ipj_internal_receive(iri_device, &rr_union, &response_id);
+
+    RETURN_ERROR_ON_INVALID_DEVICE();
+
+    ipj_internal_check_command_timeout(iri_device);
+
+    return ipj_internal_receive(iri_device, &ipj_internal_rr_union, &response_id);
+}
+
+/**
+ * This function processes incoming reports from the IRI device, like ipj_receive, but keeps
+ * requesting data and decoding frames until no more data is available or max_frames frames
+ * have been processed. This lets the User drain a burst of reports in a single call while
+ * bounding the time spent before returning to other work.
+ *
+ * The number of frames processed is returned through frame_count so the User can tell
+ * whether the budget was exhausted (more data is likely pending) or the input ran dry.
+ *
+ * \return ipj_error
+ */
+ipj_error ipj_receive_budget(
+        ipj_iri_device* iri_device,     /**< [in] IRI device data structure */
+        uint32_t        max_frames,     /**< [in] Maximum number of frames to process */
+        uint32_t*       frame_count)    /**< [out] Number of frames processed (may be NULL) */
+{
+    ipj_error error = E_IPJ_ERROR_SUCCESS;
+    uint32_t response_id;
+    uint32_t frames = 0;
+    uint32_t receive_index;
+    uint8_t sync_state;
+    bool frame_ready;
+
+    RETURN_ERROR_ON_INVALID_DEVICE();
+
+    ipj_internal_check_command_timeout(iri_device);
+
+    while (frames < max_frames)
+    {
+        /* A frame is processed on this step if it is synced and fully buffered */
+        receive_index = iri_device->receive_index;
+        sync_state = iri_device->sync_state;
+        frame_ready = (sync_state == E_GOT_FRAME_SYNC
+                && receive_index >= iri_device->frame_length);
+
+        error = ipj_internal_receive(iri_device, &ipj_internal_rr_union, &response_id);
+
+        if (frame_ready)
+        {
+            frames++;
+        }
+        else if (receive_index == iri_device->receive_index
+                && sync_state == iri_device->sync_state)
+        {
+            /* No progress was made, the input has run dry */
+            break;
+        }
+
+        if (error)
+        {
+            break;
+        }
+    }
+
+    if (frame_count)
+    {
+        *frame_count = frames;
+    }
+
+    return error;
 }
 
 /*
@@ -1252,54 +1570,197 @@ static uint16_t ipj_internal_calculate_parity_16(uint8_t* buf, int32_t len)
     return parity;
 }
 
+#if defined(IPJ_SHARED_TX_RX_BUFFER)
+static void ipj_internal_finish_receive(ipj_iri_device* iri_device)
+{
+    uint32_t start_time_ms;
+    uint32_t current_time_ms;
+    uint32_t response_id;
+
+    if (!iri_device->receive_index || !iri_device->platform_timestamp_ms_handler)
+    {
+        ipj_internal_reset_rx_state_machine(iri_device);
+        return;
+    }
+
+    /* Receive the rest of the frame in the shared buffer, reports and
+     * responses it contains are handled as usual */
+    start_time_ms = iri_device->platform_timestamp_ms_handler(
+                        iri_device->platform_timestamp_ms_args);
+
+    while (iri_device->receive_index)
+    {
+        current_time_ms = iri_device->platform_timestamp_ms_handler(
+                                iri_device->platform_timestamp_ms_args);
+
+        if (current_time_ms - start_time_ms >= IPJ_SHARED_BUFFER_DRAIN_TIMEOUT_MS
+                || ipj_internal_receive(iri_device, &ipj_internal_rr_union, &response_id))
+        {
+            break;
+        }
+    }
+
+    ipj_internal_reset_rx_state_machine(iri_device);
+}
+#endif
+
+/* Encode a command message. Define IPJ_FAST_PB_CODECS to use the encoders
+ * generated by tools/pb_fastgen.py for the commands that have one. */
+static bool ipj_internal_encode(
+        pb_ostream_t*     ostream,
+        const pb_field_t* fields,
+        const void*       src)
+{
+#if defined(IPJ_FAST_PB_CODECS)
+    const pb_fast_codec_t* codec = pb_fast_find_codec(fields);
+
+    if (codec && codec->encode)
+    {
+        return codec->encode(ostream, src);
+    }
+#endif
+
+    return pb_encode(ostream, fields, src);
+}
+
+/* Returns the pre-encoded frame for a command, or NULL if it has to be encoded */
+static const ipj_frame_template* ipj_internal_find_template(
+        const pb_field_t* cmd_field_desc,
+        const void*       cmd)
+{
+    uint32_t i;
+    ipj_action action;
+
+    if (cmd_field_desc == &Command_fields[COMMAND_FIELDS_INDEX_START])
+    {
+        const StartCommand* command = (const StartCommand*) cmd;
+
+        if (!command->has_action || command->lt_buffer_count)
+        {
+            return NULL;
+        }
+        action = command->action;
+    }
+    else if (cmd_field_desc == &Command_fields[COMMAND_FIELDS_INDEX_STOP])
+    {
+        const StopCommand* command = (const StopCommand*) cmd;
+
+        if (!command->has_action || command->lt_buffer_count)
+        {
+            return NULL;
+        }
+        action = command->action;
+    }
+    else if (cmd_field_desc == &Command_fields[COMMAND_FIELDS_INDEX_RESUME])
+    {
+        const ResumeCommand* command = (const ResumeCommand*) cmd;
+
+        if (!command->has_action)
+        {
+            return NULL;
+        }
+        action = command->action;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < sizeof(ipj_internal_frame_templates) / sizeof(ipj_internal_frame_templates[0]); i++)
+    {
+        if (ipj_internal_frame_templates[i].cmd_field_desc == cmd_field_desc
+                && ipj_internal_frame_templates[i].action == action)
+        {
+            return &ipj_internal_frame_templates[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Write a varint so that it ends at 'end'. Returns a pointer to its first byte. */
+static uint8_t* ipj_internal_prepend_varint(uint8_t* end, uint32_t value)
+{
+    uint32_t remaining = value >> 7;
+    uint8_t* start = end - 1;
+    uint8_t* bufptr;
+
+    while (remaining)
+    {
+        remaining >>= 7;
+        start--;
+    }
+
+    for (bufptr = start; value > 0x7F; value >>= 7)
+    {
+        *(bufptr++) = (uint8_t) ((value & 0x7F) | 0x80);
+    }
+    *bufptr = (uint8_t) value;
+
+    return start;
+}
+
 static ipj_error ipj_internal_transmit_packet(
         ipj_iri_device* iri_device,
         const pb_field_t* cmd_field_desc,
         void* cmd)
 {
-    bool b_result = true;
     uint32_t result;
     uint16_t number_transmitted_bytes = 0;
     uint16_t transmit_length;
     uint16_t crc;
+    uint8_t* frame;
     uint8_t* bufptr;
 
-    uint8_t* pkt_ptr = iri_device->transmit_buffer + IPJ_FRAME_HEADER_SIZE;
-    uint8_t* cmd_ptr = pkt_ptr + PB_PKT_SIZE;
-    uint8_t* msg_ptr = cmd_ptr + PB_CMD_SIZE;
+    /* The message is encoded once, leaving room in front of it for the frame
+     * header and the packet/command layers, which are filled in backwards
+     * once its length is known. The frame therefore starts PB_PKT_SIZE +
+     * PB_CMD_SIZE bytes or less into the transmit buffer. */
+    uint8_t* msg_ptr = iri_device->transmit_buffer + IPJ_FRAME_HEADER_SIZE + PB_PKT_SIZE + PB_CMD_SIZE;
+    uint8_t* msg_end;
 
-    pb_ostream_t pkt_stream = pb_ostream_from_buffer(pkt_ptr, PB_PKT_SIZE);
-    pb_ostream_t cmd_stream = pb_ostream_from_buffer(cmd_ptr, PB_CMD_SIZE);
     pb_ostream_t msg_stream = pb_ostream_from_buffer(msg_ptr, PB_MSG_SIZE);
+    const ipj_frame_template* frame_template = ipj_internal_find_template(cmd_field_desc, cmd);
 
-    /* Clear the transmit buffer to ensure we get a clean start */
-    memset(iri_device->transmit_buffer, 0x00, sizeof(iri_device->transmit_buffer));
+#if defined(IPJ_SHARED_TX_RX_BUFFER)
+    /* The command is encoded over the receive buffer */
+    ipj_internal_finish_receive(iri_device);
+#endif
 
-    /* Encode message */
-    b_result &= pb_encode(&msg_stream, (pb_field_t*) cmd_field_desc->ptr, cmd);
-    /* Encode the command tag and length */
-    b_result &= pb_encode_tag_for_field(&cmd_stream, cmd_field_desc);
-    b_result &= pb_encode_varint(&cmd_stream, msg_stream.bytes_written);
-    /* Encode the packet tag and length */
-    b_result &= pb_encode_tag_for_field(
-            &pkt_stream,
-            &Packet_fields[PACKET_FIELDS_INDEX_COMMAND]);
-    b_result &= pb_encode_varint(
-            &pkt_stream,
-            msg_stream.bytes_written + cmd_stream.bytes_written);
-    if (!b_result)
+    if (frame_template)
+    {
+        /* Copy in the pre-encoded packet, command and message layers */
+        frame = iri_device->transmit_buffer;
+        memcpy(&frame[IPJ_FRAME_HEADER_SIZE], frame_template->payload, frame_template->payload_length);
+        msg_end = &frame[IPJ_FRAME_HEADER_SIZE + frame_template->payload_length];
+    }
+    else
     {
-        return E_IPJ_ERROR_COMMAND_ENCODE_FAILURE;
+        /* Encode message */
+        if (!ipj_internal_encode(&msg_stream, (pb_field_t*) cmd_field_desc->ptr, cmd))
+        {
+            return E_IPJ_ERROR_COMMAND_ENCODE_FAILURE;
+        }
+        msg_end = msg_ptr + msg_stream.bytes_written;
+
+        /* Prepend the command tag and length */
+        bufptr = ipj_internal_prepend_varint(msg_ptr, (uint32_t) msg_stream.bytes_written);
+        bufptr = ipj_internal_prepend_varint(
+                bufptr,
+                ((uint32_t) cmd_field_desc->tag << 3) | PB_WT_STRING);
+
+        /* Prepend the packet tag and length */
+        bufptr = ipj_internal_prepend_varint(bufptr, (uint32_t) (msg_end - bufptr));
+        bufptr = ipj_internal_prepend_varint(
+                bufptr,
+                ((uint32_t) Packet_fields[PACKET_FIELDS_INDEX_COMMAND].tag << 3) | PB_WT_STRING);
+
+        frame = bufptr - IPJ_FRAME_HEADER_SIZE;
     }
 
     /* Transmit length equals 10-byte header plus the total combined length of
      * the protobufs plus 2-byte CRC */
-    transmit_length = (uint16_t) (
-            IPJ_FRAME_HEADER_SIZE    +
-            pkt_stream.bytes_written +
-            cmd_stream.bytes_written +
-            msg_stream.bytes_written +
-            IPJ_FRAME_CRC_SIZE);
+    transmit_length = (uint16_t) ((msg_end - frame) + IPJ_FRAME_CRC_SIZE);
 
     /* If a reset sync flag exists, reset the tx sync counter */
     if (iri_device->protocol_flags & IPJ_FLAG_RESET_SYNC_COUNT_MASK)
@@ -1311,7 +1772,7 @@ static ipj_error ipj_internal_transmit_packet(
     iri_device->protocol_flags &= ~IPJ_FLAG_RESET_SYNC_COUNT_MASK;
 
     /* Copy in the framing bytes + version */
-    bufptr = iri_device->transmit_buffer;
+    bufptr = frame;
     *(bufptr++) = (IPJ_MARKER >> 24) & 0xFF;
     *(bufptr++) = (IPJ_MARKER >> 16) & 0xFF;
     *(bufptr++) = (IPJ_MARKER >> 8)  & 0xFF;
@@ -1330,38 +1791,24 @@ static ipj_error ipj_internal_transmit_packet(
 
     /* Write Parity byte to header */
     *(bufptr++) = ipj_internal_calculate_parity_8(
-            iri_device->transmit_buffer,
+            frame,
             (IPJ_FRAME_HEADER_SIZE - 1));
 
-    /* Pack the protobuf data into the buffer payload area */
-    /* Set the buf pointer to the end of the packet stream area */
-    bufptr = pkt_ptr + pkt_stream.bytes_written;
-
-    /* Copy in the command data */
-    memcpy(bufptr, cmd_ptr, cmd_stream.bytes_written);
-    bufptr += cmd_stream.bytes_written;
-
-    /* Copy in the message data */
-    memcpy(bufptr, msg_ptr, msg_stream.bytes_written);
-    bufptr += msg_stream.bytes_written;
-
-    /* Note: The bufptr is now at the CRC location */
-
-    /* Calculate CRC / Parity16 */
+    /* Calculate CRC / Parity16 in one pass over the finished frame */
     if (iri_device->protocol_flags & IPJ_FLAG_ENABLE_CHECKSUM_MASK)
     {
         if (iri_device->protocol_flags & IPJ_FLAG_CHECKSUM_ALGORITHM_MASK)
         {
             // CRC - Invert CRC as per GEN2 specification
             crc = ~ipj_internal_calculate_crc(
-            iri_device->transmit_buffer,
+            frame,
             (uint16_t) transmit_length - IPJ_FRAME_CRC_SIZE);
         }
         else
         {
             // Parity
             crc = ipj_internal_calculate_parity_16(
-                    iri_device->transmit_buffer,
+                    frame,
                     (uint16_t) transmit_length - IPJ_FRAME_CRC_SIZE);
         }
     }
@@ -1370,7 +1817,8 @@ static ipj_error ipj_internal_transmit_packet(
         crc = 0x0000;
     }
 
-    /* Append CRC to transmit buffer */
+    /* Append CRC after the message */
+    bufptr = msg_end;
     *(bufptr++) = (uint8_t) (crc >> 8);
     *(bufptr++) = (uint8_t) ((crc >> 0) & 0xff);
 
@@ -1384,7 +1832,7 @@ static ipj_error ipj_internal_transmit_packet(
     uint32_t i;
     for(i = 0; i < transmit_length; i++)
     {
-        printf("%02X ", iri_device->transmit_buffer[i]);
+        printf("%02X ", frame[i]);
     }
     printf("\n");
 #endif
@@ -1393,7 +1841,7 @@ static ipj_error ipj_internal_transmit_packet(
     result = iri_device->platform_transmit_handler(
             iri_device->platform_transmit_args,
             iri_device->reader_context,
-            iri_device->transmit_buffer,
+            frame,
             transmit_length,
             &number_transmitted_bytes);
 
@@ -1416,7 +1864,7 @@ static ipj_error ipj_internal_transact(
     uint32_t current_time_ms;
     uint32_t start_time_ms;
     uint32_t response_id = 0;
-    ipj_rr_union rr_union = {{0}};
+    ipj_rr_union *rr_union = &ipj_internal_rr_union;
 
     if (!iri_device->platform_timestamp_ms_handler
             || !iri_device->platform_receive_handler)
@@ -1424,6 +1872,13 @@ static ipj_error ipj_internal_transact(
         return E_IPJ_ERROR_API_NO_HANDLER;
     }
 
+    /* Finish any asynchronous command so its response is not taken for this one */
+    error = ipj_wait_command(iri_device);
+    if (error)
+    {
+        return error;
+    }
+
     /* Transmit command */
     error = ipj_internal_transmit_packet(iri_device, cmd_field_desc, command);
     if (error)
@@ -1459,7 +1914,7 @@ static ipj_error ipj_internal_transact(
             return E_IPJ_ERROR_API_CONNECTION_READ_TIMEOUT;
         }
 
-        error = ipj_internal_receive(iri_device, &rr_union, &response_id);
+        error = ipj_internal_receive(iri_device, rr_union, &response_id);
         if (error)
         {
             return error;
@@ -1477,36 +1932,36 @@ static ipj_error ipj_internal_transact(
         if (response_id == Response_fields[RESPONSE_FIELDS_INDEX_FLASH].tag)
         {
             /* Cast receive buffer to set response */
-            if (rr_union.flash_resp.has_error)
+            if (rr_union->flash_resp.has_error)
             {
-                if (rr_union.flash_resp.error != E_IPJ_ERROR_SUCCESS)
+                if (rr_union->flash_resp.error != E_IPJ_ERROR_SUCCESS)
                 {
-                    error = (ipj_error) rr_union.flash_resp.error;
+                    error = (ipj_error) rr_union->flash_resp.error;
                     return error;
                 }
             }
         }
-        else if (rr_union.generic_resp.has_error)
+        else if (rr_union->generic_resp.has_error)
         {
-            if (rr_union.generic_resp.error != E_IPJ_ERROR_SUCCESS)
+            if (rr_union->generic_resp.error != E_IPJ_ERROR_SUCCESS)
             {
-                return rr_union.generic_resp.error;
+                return rr_union->generic_resp.error;
             }
         }
         else if (handler)
         {
             /* Call a handler to finish processing the response */
-            return handler(&rr_union, handler_args);
+            return handler(rr_union, handler_args);
         }
     }
     else if (response_id == Response_fields[COMMAND_FIELDS_INDEX_INVALID].tag)
     {
         /* Catch an InavlidResponse */
-        if (rr_union.generic_resp.has_error)
+        if (rr_union->generic_resp.has_error)
         {
-            if (rr_union.generic_resp.error != E_IPJ_ERROR_SUCCESS)
+            if (rr_union->generic_resp.error != E_IPJ_ERROR_SUCCESS)
             {
-                return rr_union.generic_resp.error;
+                return rr_union->generic_resp.error;
             }
         }
 
@@ -1522,6 +1977,291 @@ static ipj_error ipj_internal_transact(
     return E_IPJ_ERROR_SUCCESS;
 }
 
+static ipj_error ipj_internal_transmit_async(
+        ipj_iri_device                  *iri_device,
+        const pb_field_t                *cmd_field_desc,
+        void                            *command)
+{
+    ipj_error error;
+
+    if (!iri_device->platform_timestamp_ms_handler
+            || !iri_device->platform_receive_handler
+            || !iri_device->command_complete_handler)
+    {
+        return E_IPJ_ERROR_API_NO_HANDLER;
+    }
+
+    /* Only one command can be outstanding, finish the previous one */
+    error = ipj_wait_command(iri_device);
+    if (error)
+    {
+        return error;
+    }
+
+    /* Transmit command */
+    error = ipj_internal_transmit_packet(iri_device, cmd_field_desc, command);
+    if (error)
+    {
+        return error;
+    }
+
+    /* If responses are suppressed, complete straight away */
+    if ((iri_device->protocol_flags & IPJ_FLAG_SUPPRESS_SET_RESPONSES)
+            && cmd_field_desc->tag
+                    == Command_fields[COMMAND_FIELDS_INDEX_BULK_SET].tag)
+    {
+        iri_device->command_complete_handler(
+                iri_device->command_complete_args,
+                iri_device,
+                E_IPJ_ERROR_SUCCESS);
+        return E_IPJ_ERROR_SUCCESS;
+    }
+
+    /* Response id is the same as command id */
+    iri_device->pending_command_id = cmd_field_desc->tag;
+    iri_device->pending_start_ms = iri_device->platform_timestamp_ms_handler(
+                                        iri_device->platform_timestamp_ms_args);
+
+    return E_IPJ_ERROR_SUCCESS;
+}
+
+static void ipj_internal_complete_command(ipj_iri_device* iri_device, ipj_error error)
+{
+    /* Clear first, the handler may issue the next command */
+    iri_device->pending_command_id = 0;
+
+    iri_device->command_complete_handler(
+            iri_device->command_complete_args,
+            iri_device,
+            error);
+}
+
+static void ipj_internal_check_command_timeout(ipj_iri_device* iri_device)
+{
+    uint32_t current_time_ms;
+
+    if (!iri_device->pending_command_id)
+    {
+        return;
+    }
+
+    current_time_ms = iri_device->platform_timestamp_ms_handler(
+                            iri_device->platform_timestamp_ms_args);
+
+    if (current_time_ms - iri_device->pending_start_ms >= iri_device->receive_timeout_ms)
+    {
+        ipj_internal_complete_command(iri_device, E_IPJ_ERROR_API_CONNECTION_READ_TIMEOUT);
+    }
+}
+
+/*
+ * Read a varint from a wire buffer, advancing the read position.
+ * Only the low 32 bits are kept; all fields used by the tag report
+ * fast path fit in 32 bits.
+ */
+static bool ipj_internal_wire_read_varint(
+        const uint8_t **pos,
+        const uint8_t  *end,
+        uint32_t       *value)
+{
+    const uint8_t *ptr = *pos;
+    uint32_t result = 0;
+    uint8_t shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        if (ptr >= end || shift >= 64)
+        {
+            return false;
+        }
+
+        byte = *(ptr++);
+        if (shift < 32)
+        {
+            result |= (uint32_t) (byte & 0x7F) << shift;
+        }
+        shift += 7;
+    } while (byte & 0x80);
+
+    *pos = ptr;
+    *value = result;
+    return true;
+}
+
+/*
+ * Read a field key from a wire buffer and locate its value. Length
+ * delimited values are returned through data/size, all other wire types
+ * are returned through value. Fields of unknown wire type fail.
+ */
+static bool ipj_internal_wire_read_field(
+        const uint8_t  **pos,
+        const uint8_t   *end,
+        uint32_t        *field_id,
+        pb_wire_type_t  *wire_type,
+        uint32_t        *value,
+        const uint8_t  **data,
+        size_t          *size)
+{
+    uint32_t key;
+
+    if (!ipj_internal_wire_read_varint(pos, end, &key))
+    {
+        return false;
+    }
+
+    *field_id = key >> 3;
+    *wire_type = (pb_wire_type_t) (key & 0x07);
+
+    switch (*wire_type)
+    {
+        case PB_WT_VARINT:
+            return ipj_internal_wire_read_varint(pos, end, value);
+        case PB_WT_64BIT:
+            if (end - *pos < 8)
+            {
+                return false;
+            }
+            *pos += 8;
+            return true;
+        case PB_WT_STRING:
+            if (!ipj_internal_wire_read_varint(pos, end, value)
+                    || (uint32_t) (end - *pos) < *value)
+            {
+                return false;
+            }
+            *data = *pos;
+            *size = *value;
+            *pos += *value;
+            return true;
+        case PB_WT_32BIT:
+            if (end - *pos < 4)
+            {
+                return false;
+            }
+            *pos += 4;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Locate the key fields of an encoded TagOperationReport without
+ * decoding it into a TagOperationReport structure.
+ */
+static bool ipj_internal_parse_tag_report(
+        const uint8_t       *pos,
+        const uint8_t       *end,
+        ipj_tag_report_view *tag_report)
+{
+    uint32_t field_id;
+    pb_wire_type_t wire_type;
+    uint32_t value = 0;
+    const uint8_t *data = NULL;
+    size_t size = 0;
+    const uint8_t *tag_end;
+
+    memset(tag_report, 0, sizeof(ipj_tag_report_view));
+
+    while (pos < end)
+    {
+        if (!ipj_internal_wire_read_field(&pos, end, &field_id, &wire_type, &value, &data, &size))
+        {
+            return false;
+        }
+
+        if (field_id == PB_TAG_OPERATION_REPORT_TAG && wire_type == PB_WT_STRING)
+        {
+            /* Walk the embedded Tag message */
+            tag_end = data + size;
+            while (data < tag_end)
+            {
+                const uint8_t *tag_data = NULL;
+                size_t tag_size = 0;
+
+                if (!ipj_internal_wire_read_field(&data, tag_end, &field_id, &wire_type, &value, &tag_data, &tag_size))
+                {
+                    return false;
+                }
+
+                if (field_id == PB_TAG_EPC && wire_type == PB_WT_STRING)
+                {
+                    tag_report->has_epc = true;
+                    tag_report->epc = tag_data;
+                    tag_report->epc_size = tag_size;
+                }
+                else if (field_id == PB_TAG_TID && wire_type == PB_WT_STRING)
+                {
+                    tag_report->has_tid = true;
+                    tag_report->tid = tag_data;
+                    tag_report->tid_size = tag_size;
+                }
+                else if (field_id == PB_TAG_RSSI && wire_type == PB_WT_VARINT)
+                {
+                    /* RSSI is a zigzag encoded sint32 */
+                    tag_report->has_rssi = true;
+                    tag_report->rssi = (int32_t) ((value >> 1) ^ (uint32_t) -(int32_t) (value & 1));
+                }
+                else if (field_id == PB_TAG_ANTENNA && wire_type == PB_WT_VARINT)
+                {
+                    tag_report->has_antenna = true;
+                    tag_report->antenna = value;
+                }
+            }
+        }
+        else if (field_id == PB_TAG_OPERATION_REPORT_ERROR && wire_type == PB_WT_VARINT)
+        {
+            tag_report->has_error = true;
+            tag_report->error = (ipj_error) value;
+        }
+        else if (field_id == PB_TAG_OPERATION_REPORT_TYPE && wire_type == PB_WT_VARINT)
+        {
+            tag_report->has_tag_operation_type = true;
+            tag_report->tag_operation_type = (ipj_tag_operation_type) value;
+        }
+        else if (field_id == PB_TAG_OPERATION_REPORT_DATA && wire_type == PB_WT_STRING)
+        {
+            tag_report->has_tag_operation_data = true;
+            tag_report->tag_operation_data = data;
+            tag_report->tag_operation_data_size = size;
+        }
+    }
+
+    return true;
+}
+
+/* Decode a response or report message. Define IPJ_FAST_PB_CODECS to try the
+ * decoders generated by tools/pb_fastgen.py first. They only initialise the
+ * fields of the message being decoded, and give up on anything the generic
+ * decoder would handle differently, in which case the message is decoded
+ * again from the start with pb_decode(). */
+static bool ipj_internal_decode(
+        pb_istream_t*     istream,
+        const pb_field_t* fields,
+        ipj_rr_union*     rr_union)
+{
+#if defined(IPJ_FAST_PB_CODECS)
+    const pb_fast_codec_t* codec = pb_fast_find_codec(fields);
+
+    if (codec && codec->decode)
+    {
+        pb_istream_t fast_stream = *istream;
+
+        if (codec->decode(&fast_stream, rr_union))
+        {
+            *istream = fast_stream;
+            return true;
+        }
+    }
+#endif
+
+    /* Clear the decode area now that a complete frame is about to be decoded */
+    memset(rr_union, 0, sizeof(ipj_rr_union));
+
+    return pb_decode(istream, fields, rr_union);
+}
+
 static ipj_error ipj_internal_process_packet(
         ipj_iri_device *iri_device,
         uint32_t        payload_length,
@@ -1561,6 +2301,28 @@ static ipj_error ipj_internal_process_packet(
     else
     {
         pb_descriptor = Report_fields;
+
+        /* Tag operation reports go straight from the wire to the tag report
+         * handler when one is registered. The buffer stream state is the
+         * current read position in the receive buffer. */
+        if (rr_id == Report_fields[REPORT_FIELDS_INDEX_TAG_OPERATION_REPORT].tag
+                && iri_device->tag_report_handler)
+        {
+            ipj_tag_report_view tag_report;
+            const uint8_t *pos = (const uint8_t*) istream.state;
+
+            if (!ipj_internal_parse_tag_report(pos, pos + istream.bytes_left, &tag_report))
+            {
+                return E_IPJ_ERROR_COMMAND_DECODE_FAILURE;
+            }
+
+            iri_device->tag_report_handler(
+                    iri_device->tag_report_args,
+                    iri_device,
+                    &tag_report);
+
+            return E_IPJ_ERROR_SUCCESS;
+        }
     }
 
     /* Process packet */
@@ -1570,7 +2332,7 @@ static ipj_error ipj_internal_process_packet(
         if (pb_descriptor[field_index].tag == rr_id)
         {
             /* Descriptor found. Perform protobuf decode */
-            if (pb_decode(
+            if (ipj_internal_decode(
                     &istream,
                     (const pb_field_t*) pb_descriptor[field_index].ptr,
                     rr_union))
@@ -1661,6 +2423,12 @@ ipj_error ipj_internal_receive(
                 &read_length,
                 0);
 
+        /* Nothing pending, nothing to do until more data arrives */
+        if (!read_length)
+        {
+            return E_IPJ_ERROR_SUCCESS;
+        }
+
         iri_device->receive_index += read_length;
     }
     else
@@ -1680,6 +2448,14 @@ ipj_error ipj_internal_receive(
                 }
                 else /* We need to shift the buffer window*/
                 {
+                    if(iri_device->diagnostic_handler)
+                    {
+                        iri_device->diagnostic_handler(
+                            iri_device->diagnostic_args,
+                            iri_device,
+                            E_IPJ_ERROR_IRI_FRAME_SYNC_SKIPPED);
+                    }
+
                     iri_device->receive_index--;
                     memcpy(
                             iri_device->receive_buffer,
@@ -1761,16 +2537,51 @@ ipj_error ipj_internal_receive(
                         }
                     }
 
+                    *response_id = 0;
                     error = ipj_internal_process_packet(
                             iri_device,
                             iri_device->frame_length - IPJ_FRAME_HEADER_SIZE - IPJ_FRAME_CRC_SIZE,
                             rr_union,
                             response_id);
 
+                    /* Pass the response to an outstanding asynchronous command */
+                    if (!error && *response_id
+                            && *response_id == iri_device->pending_command_id)
+                    {
+                        ipj_internal_complete_command(
+                                iri_device,
+                                rr_union->generic_resp.has_error ?
+                                        rr_union->generic_resp.error : E_IPJ_ERROR_SUCCESS);
+                    }
+                    /* An InvalidResponse answers the outstanding command, whatever its id */
+                    else if (!error && iri_device->pending_command_id
+                            && *response_id == Response_fields[COMMAND_FIELDS_INDEX_INVALID].tag)
+                    {
+                        ipj_internal_complete_command(
+                                iri_device,
+                                rr_union->generic_resp.has_error ?
+                                        rr_union->generic_resp.error : E_IPJ_ERROR_API_RESPONSE_MISMATCH);
+                    }
+
+                    if(error == E_IPJ_ERROR_COMMAND_DECODE_FAILURE && iri_device->diagnostic_handler)
+                    {
+                        iri_device->diagnostic_handler(
+                            iri_device->diagnostic_args,
+                            iri_device,
+                            error);
+                    }
                 }
                 else
                 {
                     error = E_IPJ_ERROR_IRI_FRAME_INVALID;
+
+                    if(iri_device->diagnostic_handler)
+                    {
+                        iri_device->diagnostic_handler(
+                            iri_device->diagnostic_args,
+                            iri_device,
+                            error);
+                    }
                 }
 
                 ipj_internal_reset_rx_state_machine(iri_device);
@@ -1969,53 +2780,8 @@ ipj_error ipj_flash_handle_loader_block(
 
 }
 
-/* CRC-16 value table */
-static const uint16_t crc16_table[] =
-{
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
-};
-
 static uint16_t ipj_internal_calculate_crc(uint8_t* data, uint16_t data_length)
 {
-    uint16_t i = 0;
-    uint16_t crc = IPJ_CRC16_PRELOAD;
-
-    for (i = 0; i < data_length; i++, data++)
-    {
-        uint8_t tmp = *data ^ ((crc >> 8) & 0xFF);
-        crc = (crc << 8) ^ crc16_table[tmp];
-    }
-
-    return crc;
+    /* CRC-16/CCITT, see crc16.h for the software and accelerated kernels */
+    return crc16_ccitt(IPJ_CRC16_PRELOAD, data, data_length);
 }
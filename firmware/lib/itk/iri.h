@@ -56,6 +56,8 @@ typedef uint32_t ipj_handler_type;
 #define E_IPJ_HANDLER_TYPE_DIAGNOSTIC                 ((ipj_handler_type)(0x7))
 #define E_IPJ_HANDLER_TYPE_PLATFORM_MODIFY_CONNECTION ((ipj_handler_type)(0x8))
 #define E_IPJ_HANDLER_TYPE_PLATFORM_FLUSH_PORT        ((ipj_handler_type)(0x9))
+#define E_IPJ_HANDLER_TYPE_TAG_REPORT                 ((ipj_handler_type)(0xA))
+#define E_IPJ_HANDLER_TYPE_COMMAND_COMPLETE           ((ipj_handler_type)(0xB))
 
 
 typedef uint32_t ipj_idle_power_mode;
@@ -606,6 +608,10 @@ typedef uint32_t ipj_report_timestamp_flag;
 
 #endif
 
+// Diagnostic code for bytes skipped while searching for a frame header, not
+// sent by the reader, only passed to the diagnostic handler by ipj_receive
+#define E_IPJ_ERROR_IRI_FRAME_SYNC_SKIPPED             ((ipj_error)(0x3000003))
+
 // *****************************************************************************
 // IRI API Structs
 // *****************************************************************************
@@ -1000,6 +1006,61 @@ typedef void (*DIAGNOSTIC_HANDLER)(
         struct ipj_iri_device* iri_device,
         ipj_error error);
 
+/* TAG REPORT HANDLER TYPEDEF */
+/**
+ * Key fields of a tag operation report, located directly in the received
+ * frame. Byte fields point into the IRI device receive buffer and are only
+ * valid for the duration of the tag report handler call.
+ */
+typedef struct
+{
+    bool has_error;
+    ipj_error error;
+    bool has_epc;
+    const uint8_t* epc;
+    size_t epc_size;
+    bool has_tid;
+    const uint8_t* tid;
+    size_t tid_size;
+    bool has_rssi;
+    int32_t rssi;
+    bool has_antenna;
+    uint32_t antenna;
+    bool has_tag_operation_type;
+    ipj_tag_operation_type tag_operation_type;
+    bool has_tag_operation_data;
+    const uint8_t* tag_operation_data;
+    size_t tag_operation_data_size;
+} ipj_tag_report_view;
+
+/**
+ * This function is called when a complete tag operation report is
+ * received by the IRI library. When registered, tag operation reports
+ * are passed to this handler instead of being decoded for the report
+ * handler.
+ */
+typedef ipj_error (*TAG_REPORT_HANDLER_EXT)(
+        void* opaque_args,
+        struct ipj_iri_device* iri_device,
+        ipj_tag_report_view* tag_report);
+typedef ipj_error (*TAG_REPORT_HANDLER)(
+        struct ipj_iri_device* iri_device,
+        ipj_tag_report_view* tag_report);
+
+/* COMMAND COMPLETE HANDLER TYPEDEF */
+/**
+ * This function is called when the response to an asynchronous command
+ * (ipj_*_async) is received, or when the response times out. Only one
+ * asynchronous command is outstanding at a time.
+ */
+typedef void (*COMMAND_COMPLETE_HANDLER_EXT)(
+        void* opaque_args,
+        struct ipj_iri_device* iri_device,
+        ipj_error error);
+typedef void (*COMMAND_COMPLETE_HANDLER)(
+        struct ipj_iri_device* iri_device,
+        ipj_error error);
+
 /*****************************************************************************
  *                                                                           *
  * IRI API - IRI Device Structure                                            *
@@ -1014,6 +1075,18 @@ typedef void (*DIAGNOSTIC_HANDLER)(
 #define IPJ_DEFAULT_TRANSMIT_TIMEOUT_MS 1250
 #define IPJ_DEFAULT_RECEIVE_TIMEOUT_MS  1250
 
+/* Half-duplex buffer mode */
+/**
+ * Define IPJ_SHARED_TX_RX_BUFFER to encode commands into the receive buffer
+ * instead of a separate transmit buffer, saving IPJ_TRANSMIT_BUFFER_SIZE
+ * bytes per device. A frame that is partly received when a command is sent
+ * is completed first, or dropped if the rest of it does not arrive within
+ * IPJ_SHARED_BUFFER_DRAIN_TIMEOUT_MS. Not defined by default: a device in
+ * static memory frees .bss, not heap, so the saving only helps once the
+ * memory layout gives it to the heap.
+ */
+#define IPJ_SHARED_BUFFER_DRAIN_TIMEOUT_MS 100
+
 /* IRI device structure */
 /**
  * User application allocates or declares structure before connecting
@@ -1050,6 +1123,10 @@ struct ipj_iri_device {
     void*              report_args;
     DIAGNOSTIC_HANDLER_EXT diagnostic_handler;
     void*                  diagnostic_args;
+    TAG_REPORT_HANDLER_EXT tag_report_handler;
+    void*                  tag_report_args;
+    COMMAND_COMPLETE_HANDLER_EXT command_complete_handler;
+    void*                        command_complete_args;
 
     /* Timeouts */
     uint32_t transmit_timeout_ms;
@@ -1062,9 +1139,20 @@ struct ipj_iri_device {
     uint8_t                         tx_frame_sync_count;
     uint8_t                         sync_state;
     uint32_t                        frame_length;
+#if defined(IPJ_SHARED_TX_RX_BUFFER)
+    uint32_t                        receive_index;
+    union
+    {
+        uint8_t                     transmit_buffer[IPJ_TRANSMIT_BUFFER_SIZE];
+        uint8_t                     receive_buffer[IPJ_RECEIVE_BUFFER_SIZE];
+    };
+#else
     uint8_t                         transmit_buffer[IPJ_TRANSMIT_BUFFER_SIZE];
     uint32_t                        receive_index;
     uint8_t                         receive_buffer[IPJ_RECEIVE_BUFFER_SIZE];
+#endif
+    uint32_t                        pending_command_id;
+    uint32_t                        pending_start_ms;
 };
 
 typedef struct ipj_iri_device ipj_iri_device;
@@ -1100,6 +1188,12 @@ ipj_error ipj_modify_connection(
         ipj_connection_params* params);
 ipj_error ipj_disconnect(ipj_iri_device* iri_device);
 ipj_error ipj_receive(ipj_iri_device* iri_device);
+ipj_error ipj_receive_budget(
+        ipj_iri_device* iri_device,
+        uint32_t max_frames,
+        uint32_t* frame_count);
+ipj_error ipj_wait_command(ipj_iri_device* iri_device);
+bool      ipj_command_pending(ipj_iri_device* iri_device);
 ipj_error ipj_suppress_set_responses(ipj_iri_device* iri_device);
 ipj_error ipj_resume_set_responses(ipj_iri_device* iri_device);
 ipj_error ipj_set_receive_timeout_ms(ipj_iri_device* iri_device, uint32_t timeout_ms);
@@ -1170,6 +1264,21 @@ ipj_error ipj_stop(
         ipj_iri_device* iri_device       /*[in]*/,
         ipj_action      action           /*[in]*/);
 
+ipj_error ipj_bulk_set_async(
+        ipj_iri_device* iri_device       /*[in]*/,
+        ipj_key_value*  key_value        /*[in]*/,
+        uint32_t        key_value_count  /*[in]*/,
+        ipj_key_list*   key_list         /*[in]*/,
+        uint32_t        key_list_count   /*[in]*/);
+
+ipj_error ipj_start_async(
+        ipj_iri_device* iri_device       /*[in]*/,
+        ipj_action      action           /*[in]*/);
+
+ipj_error ipj_stop_async(
+        ipj_iri_device* iri_device       /*[in]*/,
+        ipj_action      action           /*[in]*/);
+
 ipj_error ipj_flash_write(
         ipj_iri_device *iri_device       /*[in]*/,
         uint32_t        offset           /*[in]*/,
@@ -54,6 +54,7 @@ uint32_t platform_modify_connection_handler(
 void     platform_sleep_ms_handler(uint32_t milliseconds);
 uint32_t platform_reset_pin_handler(IPJ_READER_CONTEXT reader_context, bool enable);
 uint32_t platform_wakeup_pin_handler(IPJ_READER_CONTEXT reader_context, bool enable);
+uint32_t platform_rx_overflow_count(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,215 @@
+#include "prefixset.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Parent index of a prefix not enclosed by any other prefix
+#define PREFIXSET_NO_PARENT 0xFFFF
+
+// Gets a prefix set entry
+static inline uint8_t* getEntry(prefixset* p, uint16_t index) {
+	return p->table + (index * p->keySize);
+}
+
+// Checks whether a key starts with the prefix of an entry
+static inline int8_t isPrefixOf(prefixset* p, uint16_t index, const uint8_t* key) {
+	uint8_t *entry = getEntry(p, index);
+	uint16_t bytes = p->bitLength[index] / 8;
+	uint8_t bits = p->bitLength[index] % 8;
+
+	if (memcmp(entry, key, bytes) != 0) {
+		return 0;
+	}
+	if (bits != 0 && (key[bytes] & (uint8_t)(0xFF << (8 - bits))) != entry[bytes]) {
+		return 0;
+	}
+	return 1;
+}
+
+// Compares an entry with a prefix, ordering by value then by length
+// Returns: Less than, equal to or greater than zero as the entry orders before,
+//          the same as or after the prefix
+static int compareEntry(prefixset* p, uint16_t index, const uint8_t* prefix, uint16_t bitLength) {
+	int result = memcmp(getEntry(p, index), prefix, p->keySize);
+	if (result != 0) {
+		return result;
+	}
+	return (int)p->bitLength[index] - (int)bitLength;
+}
+
+// Finds the position of a prefix in the sorted table
+// Parameters:
+//   found: Set to 1 if the prefix is in the table at the returned position
+// Returns: The index of the prefix, or the index to insert it at
+static uint16_t findEntry(prefixset* p, const uint8_t* prefix, uint16_t bitLength, uint8_t* found) {
+	uint16_t low = 0;
+	uint16_t high = p->length;
+
+	*found = 0;
+	while (low < high) {
+		uint16_t mid = (low + high) / 2;
+		int result = compareEntry(p, mid, prefix, bitLength);
+		if (result == 0) {
+			*found = 1;
+			return mid;
+		} else if (result < 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+// Copies a prefix into the scratch entry, clearing the bits past its length
+static uint8_t* setScratch(prefixset* p, const uint8_t* prefix, uint16_t bitLength) {
+	uint8_t *scratch = getEntry(p, p->tableSize);
+	uint16_t bytes = bitLength / 8;
+	uint8_t bits = bitLength % 8;
+
+	memset(scratch, 0, p->keySize);
+	memcpy(scratch, prefix, bytes);
+	if (bits != 0) {
+		scratch[bytes] = prefix[bytes] & (uint8_t)(0xFF << (8 - bits));
+	}
+	return scratch;
+}
+
+// Links each entry to the closest shorter entry that is a prefix of it
+// Notes: Sorting puts an entry after all the entries enclosing it, so the
+// enclosing entries of an entry are found among the previous entry's parents
+static void updateParents(prefixset* p) {
+	uint16_t i;
+	uint16_t parent;
+
+	for (i = 0; i < p->length; i++) {
+		parent = (i == 0) ? PREFIXSET_NO_PARENT : i - 1;
+		while (parent != PREFIXSET_NO_PARENT
+				&& !(p->bitLength[parent] < p->bitLength[i] && isPrefixOf(p, parent, getEntry(p, i)))) {
+			parent = p->parent[parent];
+		}
+		p->parent[i] = parent;
+	}
+}
+
+// Initialise a prefix set
+// Parameters:
+//   p: Pointer to a prefix set
+//   tableSize: Maximum number of prefixes to store
+//   keySize: Size of the keys matched against the prefixes, in bytes
+void prefixset_init(prefixset* p, uint16_t tableSize, uint16_t keySize) {
+	p->keySize = keySize;
+	p->tableSize = tableSize;
+	p->length = 0;
+
+	// One extra entry holds the prefix being added or removed
+	p->table = (uint8_t*)malloc((tableSize + 1) * keySize * sizeof(uint8_t));
+	p->bitLength = (uint16_t*)malloc(tableSize * sizeof(uint16_t));
+	p->parent = (uint16_t*)malloc(tableSize * sizeof(uint16_t));
+}
+
+// Frees all resources used by a prefix set
+// Parameters:
+//   p: Pointer to prefix set to destroy
+void prefixset_destroy(prefixset *p) {
+	free(p->table);
+	free(p->bitLength);
+	free(p->parent);
+}
+
+// Add a prefix to the prefix set
+// Parameters:
+//   p: Pointer to prefix set to add to
+//   prefix: The prefix data, keySize bytes, bits past bitLength are ignored
+//   bitLength: Length of the prefix, in bits, at most keySize * 8
+// Returns: PREFIXSET_OK on success,
+//          PREFIXSET_RULE_EXISTS if the prefix is already in the set,
+//          PREFIXSET_TABLE_FULL if the prefix set is full
+uint8_t prefixset_add(prefixset* p, const uint8_t* prefix, uint16_t bitLength) {
+	uint8_t found;
+	uint8_t *scratch = setScratch(p, prefix, bitLength);
+	uint16_t index = findEntry(p, scratch, bitLength, &found);
+
+	if (found) {
+		return PREFIXSET_RULE_EXISTS;
+	}
+	if (p->length >= p->tableSize) {
+		return PREFIXSET_TABLE_FULL;
+	}
+
+	// Shift the following entries up and insert
+	memmove(getEntry(p, index + 1), getEntry(p, index), (p->length - index) * p->keySize);
+	memmove(&p->bitLength[index + 1], &p->bitLength[index], (p->length - index) * sizeof(uint16_t));
+	memcpy(getEntry(p, index), scratch, p->keySize);
+	p->bitLength[index] = bitLength;
+	++p->length;
+
+	updateParents(p);
+	return PREFIXSET_OK;
+}
+
+// Remove a prefix from the prefix set
+// Parameters:
+//   p: Pointer to prefix set to remove from
+//   prefix: The prefix data, keySize bytes, bits past bitLength are ignored
+//   bitLength: Length of the prefix, in bits
+// Returns: PREFIXSET_OK on success,
+//          PREFIXSET_NOT_FOUND if the prefix is not in the set
+uint8_t prefixset_remove(prefixset* p, const uint8_t* prefix, uint16_t bitLength) {
+	uint8_t found;
+	uint8_t *scratch = setScratch(p, prefix, bitLength);
+	uint16_t index = findEntry(p, scratch, bitLength, &found);
+
+	if (!found) {
+		return PREFIXSET_NOT_FOUND;
+	}
+
+	// Shift the following entries down
+	--p->length;
+	memmove(getEntry(p, index), getEntry(p, index + 1), (p->length - index) * p->keySize);
+	memmove(&p->bitLength[index], &p->bitLength[index + 1], (p->length - index) * sizeof(uint16_t));
+
+	updateParents(p);
+	return PREFIXSET_OK;
+}
+
+// Check whether a key starts with any prefix in the prefix set
+// Parameters:
+//   p: Pointer to prefix set to search
+//   key: The key data, keySize bytes
+// Returns: 1 if a prefix matches, 0 otherwise
+uint8_t prefixset_match(prefixset* p, const uint8_t* key) {
+	uint16_t low = 0;
+	uint16_t high = p->length;
+
+	// Find the last entry ordered at or before the key
+	while (low < high) {
+		uint16_t mid = (low + high) / 2;
+		if (memcmp(getEntry(p, mid), key, p->keySize) <= 0) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	if (low == 0) {
+		return 0;
+	}
+
+	// Any matching prefix is that entry or one of the entries enclosing it
+	uint16_t index = low - 1;
+	while (index != PREFIXSET_NO_PARENT) {
+		if (isPrefixOf(p, index, key)) {
+			return 1;
+		}
+		index = p->parent[index];
+	}
+	return 0;
+}
+
+// Empties all prefixes from a prefix set
+// Parameters:
+//    p: Pointer to prefix set to empty
+void prefixset_reset(prefixset* p) {
+	p->length = 0;
+}
@@ -0,0 +1,82 @@
+/*
+*  Prefix set implementation
+*/
+
+#ifndef PREFIXSET_H_
+#define PREFIXSET_H_
+
+#include <stdint.h>
+
+// Prefix set version
+#define PREFIXSET_VERSION 1.0.0
+
+// Prefix set result codes
+#define PREFIXSET_OK 0
+#define PREFIXSET_RULE_EXISTS 1
+#define PREFIXSET_TABLE_FULL 2
+#define PREFIXSET_NOT_FOUND 3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Prefix set, a table of bit prefixes sorted for binary search
+typedef struct _prefixset {
+	uint16_t keySize;
+	uint16_t tableSize;
+	uint16_t length;
+	uint8_t *table;
+	uint16_t *bitLength;
+	uint16_t *parent;
+} prefixset;
+
+// Initialise a prefix set
+// Parameters:
+//   p: Pointer to a prefix set
+//   tableSize: Maximum number of prefixes to store
+//   keySize: Size of the keys matched against the prefixes, in bytes
+void prefixset_init(prefixset* p, uint16_t tableSize, uint16_t keySize);
+
+// Add a prefix to the prefix set
+// Parameters:
+//   p: Pointer to prefix set to add to
+//   prefix: The prefix data, keySize bytes, bits past bitLength are ignored
+//   bitLength: Length of the prefix, in bits, at most keySize * 8
+// Returns: PREFIXSET_OK on success,
+//          PREFIXSET_RULE_EXISTS if the prefix is already in the set,
+//          PREFIXSET_TABLE_FULL if the prefix set is full
+uint8_t prefixset_add(prefixset* p, const uint8_t* prefix, uint16_t bitLength);
+
+// Remove a prefix from the prefix set
+// Parameters:
+//   p: Pointer to prefix set to remove from
+//   prefix: The prefix data, keySize bytes, bits past bitLength are ignored
+//   bitLength: Length of the prefix, in bits
+// Returns: PREFIXSET_OK on success,
+//          PREFIXSET_NOT_FOUND if the prefix is not in the set
+uint8_t prefixset_remove(prefixset* p, const uint8_t* prefix, uint16_t bitLength);
+
+// Check whether a key starts with any prefix in the prefix set
+// Parameters:
+//   p: Pointer to prefix set to search
+//   key: The key data, keySize bytes
+// Returns: 1 if a prefix matches, 0 otherwise
+// Notes: Takes one binary search over the prefixes, plus one comparison for
+// each shorter prefix that encloses the closest prefix
+uint8_t prefixset_match(prefixset* p, const uint8_t* key);
+
+// Empties all prefixes from a prefix set
+// Parameters:
+//    p: Pointer to prefix set to empty
+void prefixset_reset(prefixset* p);
+
+// Frees all resources used by a prefix set
+// Parameters:
+//   p: Pointer to prefix set to destroy
+void prefixset_destroy(prefixset *p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PREFIXSET_H_
@@ -9,6 +9,7 @@ HDLC library.
 #include "dn_hdlc.h"
 #include "dn_uart.h"
 #include "dn_lock.h"
+#include "crc16.h"
 
 //=========================== variables =======================================
 
@@ -19,7 +20,6 @@ typedef struct {
    uint8_t              lastRxByte;
    bool                 busyReceiving;
    bool                 inputEscaping;
-   uint16_t             inputCrc;
    uint8_t              inputBufFill;
    uint8_t              inputBuf[DN_HDLC_INPUT_BUFFER_SIZE];
    // output
@@ -187,9 +187,6 @@ void dn_hdlc_outputClose() {
 void dn_hdlc_inputOpen() {
    // reset the input buffer index
    dn_hdlc_vars.inputBufFill = 0;
-   
-   // initialize the value of the CRC
-   dn_hdlc_vars.inputCrc = DN_HDLC_CRCINIT;
 }
 
 /**
@@ -209,9 +206,6 @@ void dn_hdlc_inputWrite(uint8_t b) {
       // add byte to input buffer
       dn_hdlc_vars.inputBuf[dn_hdlc_vars.inputBufFill] = b;
       dn_hdlc_vars.inputBufFill++;
-      
-      // iterate through CRC calculator
-      dn_hdlc_vars.inputCrc = dn_hdlc_crcIteration(dn_hdlc_vars.inputCrc,b);
    }
 }
 
@@ -220,8 +214,9 @@ void dn_hdlc_inputWrite(uint8_t b) {
 */
 void dn_hdlc_inputClose() {
    
-   // verify the validity of the frame
-   if (dn_hdlc_vars.inputCrc==DN_HDLC_CRCGOOD) {
+   // verify the validity of the frame, the CRC is computed over the whole
+   // unescaped frame at once rather than per received byte
+   if (crc16_x25(DN_HDLC_CRCINIT,dn_hdlc_vars.inputBuf,dn_hdlc_vars.inputBufFill)==DN_HDLC_CRCGOOD) {
       // the CRC is correct
       
       // remove the CRC from the input buffer
@@ -248,5 +243,5 @@ void dn_hdlc_inputClose() {
 \return The updated CRC running value.
 */
 uint16_t dn_hdlc_crcIteration(uint16_t crc, uint8_t b) {
-   return (crc >> 8) ^ dn_hdlc_fcstab[(crc ^ b) & 0xff];
+   return crc16_x25Byte(crc,b);
 }
@@ -0,0 +1,62 @@
+#include <crc16.h>
+
+#if defined(CRC16_HW_ENABLE)
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <drivers/crc/adi_crc.h>
+
+#include "../assert.h"
+
+// CRC-16/CCITT polynomial, aligned to the top of the 32-bit CRC engine
+#define CRC16_HW_POLYNOMIAL (0x1021UL << 16)
+
+// CRC peripheral memory
+static uint8_t _crcMemory[ADI_CRC_MEMORY_SIZE];
+// CRC peripheral handle
+static ADI_CRC_HANDLE _crc = 0;
+
+// Calculate a CRC-16/CCITT over a buffer using the CRC accelerator
+// Parameters:
+//   crc: Initial CRC value
+//   data: Data to checksum
+//   length: Size of the data, in bytes
+// Returns: The updated CRC value
+// Notes: The 32-bit engine runs MSB first with the 16-bit polynomial and seed in
+// its upper half, leaving the CRC-16 in the upper half of the result
+uint16_t crc16_hwCcitt(uint16_t crc, const uint8_t *data, uint32_t length) {
+	ADI_CRC_RESULT eCrcResult;
+	bool inProgress = true;
+	uint32_t result;
+
+	// Open the CRC peripheral on first use
+	if (_crc == 0) {
+		eCrcResult = adi_crc_Open(0, _crcMemory, ADI_CRC_MEMORY_SIZE, &_crc);
+		ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+		eCrcResult = adi_crc_SetPolynomialVal(_crc, CRC16_HW_POLYNOMIAL);
+		ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+		eCrcResult = adi_crc_SetBitMirroring(_crc, false);
+		ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+		eCrcResult = adi_crc_SetByteMirroring(_crc, false);
+		ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+	}
+
+	eCrcResult = adi_crc_SetCrcSeedVal(_crc, (uint32_t)crc << 16);
+	ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+	eCrcResult = adi_crc_Compute(_crc, data, length, 0);
+	ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+
+	// Wait for the CRC to complete
+	while (inProgress) {
+		eCrcResult = adi_crc_IsCrcInProgress(_crc, &inProgress);
+		ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+	}
+
+	eCrcResult = adi_crc_GetFinalCrcVal(_crc, &result);
+	ASSERT_RESULT(eCrcResult, ADI_CRC_SUCCESS);
+
+	return (uint16_t)(result >> 16);
+}
+
+#endif // CRC16_HW_ENABLE
@@ -34,6 +34,8 @@ static uint8_t _rxBuff2;
 static uint8_t _rxCircBuff[RX_BUFFER_SIZE];
 static volatile uint8_t _rxCircGet = 0;
 static volatile uint8_t _rxCircPut = 0;
+// Number of bytes lost to circular receive buffer overflows
+static volatile uint32_t _rxOverflowCount = 0;
 
 // Baud rate configuration struct
 struct UartBaudSt {
@@ -80,6 +82,7 @@ static void uartCallback(void *pCBParam, uint32_t event, void *pArg) {
 		_rxCircBuff[_rxCircPut++] = *((uint8_t*)pArg);
 		if (_rxCircGet == _rxCircPut) {
 			_rxCircGet++;
+			_rxOverflowCount++;
 		}
 		if (_rxCircPut >= RX_BUFFER_SIZE) {
 			_rxCircPut = 0;
@@ -188,6 +191,11 @@ uint32_t platform_receive_handler(IPJ_READER_CONTEXT readerCtx, uint8_t* buffer,
 	return IPJ_FAILED;
 }
 
+// Number of received bytes lost to receive buffer overflows
+uint32_t platform_rx_overflow_count() {
+	return _rxOverflowCount;
+}
+
 // Provide timestamp
 uint32_t platform_timestamp_ms_handler() {
     return timer_getTicks();
@@ -9,6 +9,7 @@
 #include <drivers/pwr/adi_pwr.h>
 #include <drivers/gpio/adi_gpio.h>
 #include <hashset.h>
+#include <crc16.h>
 
 #include "led.h"
 #include "timer.h"
@@ -36,11 +37,132 @@
 #define RFID_READ_TIMEOUT 1000 // milliseconds
 // Duration to wait between reads
 #define RFID_READ_INTERVAL 1 // milliseconds
+// Set to 1 to have the reader end each read by itself after RFID_READ_TIMEOUT
+#define RFID_READ_AUTOSTOP 1
+// Additional time to wait for the reader to stop by itself
+#define RFID_READ_AUTOSTOP_MARGIN 250 // milliseconds
+// Set to 1 to size each read to the tag population instead of RFID_READ_TIMEOUT:
+// a read ends once no new unique tags have been found for RFID_READ_QUIET_PERIOD,
+// or after RFID_READ_MAX_TIMEOUT if new tags are still being found
+#define RFID_READ_ADAPTIVE 0
+// Minimum duration of an adaptive read, covers the reader start up
+#define RFID_READ_MIN_TIMEOUT 100 // milliseconds
+// Time without a new unique tag after which an adaptive read ends
+#define RFID_READ_QUIET_PERIOD 200 // milliseconds
+// Maximum duration of an adaptive read
+#define RFID_READ_MAX_TIMEOUT 3000 // milliseconds
+// Maximum number of reader frames to read in a row while the reader has a
+// backlog, before the mesh events are processed again
+#define RFID_READ_FRAMES_PER_YIELD 64 // frames
+
+// Duration the reader is asked to read for
+#if RFID_READ_ADAPTIVE
+#define RFID_READ_DURATION RFID_READ_MAX_TIMEOUT
+#else
+#define RFID_READ_DURATION RFID_READ_TIMEOUT
+#endif
+
+// Set to 1 to shorten reads and lengthen the gap between them while the reader
+// is hot, holding it under RFID_THERMAL_TARGET instead of letting its thermal
+// protection throttle transmit part way through a read
+#define RFID_THERMAL_CONTROL 0
+// Temperature to hold the hottest of the PA and internal sensors under
+#define RFID_THERMAL_TARGET 70 // degrees C
+// Margin below RFID_THERMAL_TARGET before the duty cycle is raised again
+#define RFID_THERMAL_HYSTERESIS 5 // degrees C
+// Duty cycle reduction for each degree above RFID_THERMAL_TARGET
+#define RFID_THERMAL_STEP_DOWN 5 // percent per degree C
+// Duty cycle increase for each sample below the hysteresis margin
+#define RFID_THERMAL_STEP_UP 5 // percent
+// Lowest duty cycle, share of time spent reading
+#define RFID_THERMAL_MIN_DUTY 20 // percent
+// Reads between temperature samples, each sample waits for the reader to stop
+// and queries it between reads
+#define RFID_THERMAL_SAMPLE_READS 10 // reads
+
+// Set to 1 to select the inventory strategy for each read from the results of
+// the previous read, otherwise RFID_STRATEGY_DEFAULT is used for every read
+#define RFID_STRATEGY_AUTO 0
+// Population at which a dual target read with mostly duplicates moves to single target
+#define RFID_STRATEGY_LARGE_POPULATION 64 // tags
+// Population below which a read returns to dual target
+#define RFID_STRATEGY_SMALL_POPULATION 32 // tags
+// Share of duplicate reads at which strong tags are taken to be drowning out weak ones
+#define RFID_STRATEGY_DUPLICATE_RATIO 75 // percent
+// Share of the previous read's tags below which a single target or tag focus
+// read is taken to have started with the tags in the wrong target state
+#define RFID_STRATEGY_CARRYOVER 50 // percent
+
+// Set to 1 to adjust the transmit power after each read, between RFID_TX_POWER_MIN
+// and RFID_TX_POWER_MAX, for the most in-zone tags per second for each watt of RF
+#define RFID_TX_POWER_CONTROL 0
+// Transmit power bounds
+#define RFID_TX_POWER_MIN 1500 // dBm x 100
+#define RFID_TX_POWER_MAX RFID_TX_POWER // dBm x 100
+// Transmit power change for each adjustment
+#define RFID_TX_POWER_STEP 100 // dBm x 100
+// Share of reads from out of zone tags, dropped by the host tag filter, at which
+// a lower transmit power is tried. RSSI gated reads are not counted, as every
+// step down weakens the in-zone tags too
+#define RFID_TX_POWER_OUT_OF_ZONE 20 // percent
+// Share of weak reads at which marginal tags are taken to be missed and the
+// transmit power is raised, see RFID_RSSI_WEAK
+#define RFID_TX_POWER_WEAK_RATIO 25 // percent
+// Share of the tags, and of the tags per second, read at RFID_TX_POWER_MAX that
+// a read at lower power must keep for the lower power to be kept. A 1dB step
+// saves 21% of the RF power, so at 80% of the tags per second the tags per watt
+// still improve
+#define RFID_TX_POWER_KEEP_TAGS 90 // percent
+#define RFID_TX_POWER_KEEP_RATE 80 // percent
+// Reads to wait at a power before trying a lower power again
+#define RFID_TX_POWER_HOLD_READS 20 // reads
+// Reads below RFID_TX_POWER_MAX before a read at RFID_TX_POWER_MAX refreshes
+// the tags and tags per second lower powers are checked against
+#define RFID_TX_POWER_REFRESH_READS 50 // reads
+
+// Set to 1 to have the reader only inventory tags matching _selectFilters
+#define RFID_SELECT_FILTERS 0
+
+// Host tag filter policy for the EPC prefixes in _tagFilterPrefixes, see RFID_TAG_FILTER_*
+#define RFID_TAG_FILTER RFID_TAG_FILTER_NONE
+// Maximum number of host tag filter prefixes
+#define RFID_TAG_FILTER_ITEMS 64 // prefixes
+
+// Tags are only reported once they have been read RFID_RSSI_MIN_READS times at
+// or above RFID_RSSI_THRESHOLD in a read, set to 0 to report every tag read
+#define RFID_RSSI_MIN_READS 0 // reads
+// Minimum RSSI of a tag read, weaker reads are dropped when RFID_RSSI_MIN_READS is set
+#define RFID_RSSI_THRESHOLD -6500 // dBm x 100
 
 // Maximum amount of tags that can be included in a single message
 #define TRANSMIT_TAG_MAX_ITEMS ((MOTE_MAX_DATA_SIZE - RFID_TAG_UPDATE_SIZE) / TAG_DATA_SIZE)
 // Amount of time to delay in between sending tags
 #define TRANSMIT_TAG_UPDATE_INTERVAL 10 // milliseconds
+// Interval between RFID link statistics notifications
+#define TRANSMIT_LINK_STATS_INTERVAL 300000 // milliseconds
+
+#if RFID_SELECT_FILTERS
+// Reader Select filters, at most RFID_SELECT_MAX_FILTERS
+static const rfid_select_filter _selectFilters[] = {
+	// Only tags with this EPC header and company prefix
+	{ E_IPJ_MEM_BANK_EPC, RFID_SELECT_EPC_POINTER, 32, { 0x30, 0x14, 0x00, 0x00 }, RFID_SELECT_INCLUDE },
+};
+#endif
+
+#if RFID_TAG_FILTER != RFID_TAG_FILTER_NONE
+// Host tag filter EPC prefix
+typedef struct {
+	uint8_t prefix[EPC_SIZE];
+	uint16_t bitLength;
+} tag_filter_prefix;
+// Host tag filter EPC prefixes loaded at start up, more can be added at runtime
+static const tag_filter_prefix _tagFilterPrefixItems[] = {
+	// SGTIN-96 header, filter value 1 and a 24 bit company prefix
+	{ { 0x30, 0x34, 0x25, 0x7B, 0xF4 }, 38 },
+};
+// Host tag filter EPC prefixes
+static prefixset _tagFilterPrefixes;
+#endif
 
 // GPIO peripheral memory
 static uint8_t _gpioMemory[ADI_GPIO_MEMORY_SIZE];
@@ -66,6 +188,51 @@ static volatile uint32_t _nextTimeout = 0;
 static hashset _hashset;
 // Hashset iterator for iterating the current unique entries in the hashset
 static hashset_iterator _hashsetIterator;
+#if RFID_READ_ADAPTIVE
+// Start of the current read
+static uint32_t _readStartTimestamp = 0;
+// Time the last new unique tag was found in the current read
+static uint32_t _readDiscoveryTimestamp = 0;
+// Number of unique tags found so far in the current read
+static uint16_t _readUniqueCount = 0;
+#endif
+#if RFID_THERMAL_CONTROL
+// Share of time spent reading, lowered while the reader is hot
+static uint8_t _thermalDuty = 100;
+// Maximum duration of the next read
+static uint32_t _readWindow = RFID_READ_DURATION;
+// Reads left before the next temperature sample
+static uint8_t _thermalSampleReads = 0;
+#endif
+#if RFID_THERMAL_CONTROL || RFID_TX_POWER_CONTROL
+// Start and duration of the last read, for the thermal gap and the tag rate
+static uint32_t _readBeginTimestamp = 0;
+static uint32_t _readLastDuration = 0;
+#endif
+#if RFID_TX_POWER_CONTROL
+// Tags and tags per second read at RFID_TX_POWER_MAX
+static uint16_t _txPowerRefCount = 0;
+static uint32_t _txPowerRefRate = 0;
+// Reads left before a read at RFID_TX_POWER_MAX refreshes the reference
+static uint8_t _txPowerRefreshReads = RFID_TX_POWER_REFRESH_READS;
+// Power to go back to after the reference read, 0 if none
+static uint16_t _txPowerResume = 0;
+// Reads left before trying a lower power again
+static uint8_t _txPowerHold = RFID_TX_POWER_HOLD_READS;
+// Reads left before trying a lower power for out of zone tags again, after a
+// step down that lost tags
+static uint8_t _txPowerOutOfZoneHold = 0;
+#endif
+#if RFID_STRATEGY_AUTO
+// Number of unique tags found by the previous read
+static uint16_t _strategyLastCount = 0;
+// Whether single target reads alternate between A to B and B to A, set while
+// tags keep their target state from one read to the next
+static bool _strategyAlternate = true;
+// Whether tag focus is left out, set once tag focus reads have found the tags
+// still in B from the read before, until the next dual target read
+static bool _strategyFocusCarryover = false;
+#endif
 
 // Buffer to store the data for the SmartMesh message currently being sent
 static uint8_t _transmitBuffer[TRANSMIT_TAG_MAX_ITEMS * TAG_DATA_SIZE];
@@ -75,10 +242,17 @@ static volatile bool _lastTransmitOk = true;
 static uint8_t _transmitMsgId = 0;
 // Stores the number of tags currently being transmitted
 static uint8_t _transmitTagCount = 0;
+// Stores whether the message currently being transmitted is the link statistics
+static bool _transmitLinkStats = false;
+// Link statistics currently being transmitted
+static rfid_link_stats _linkStats;
+// Timeout for the next link statistics notification
+static uint32_t _linkStatsTimeout = 0;
 
 // SmartMesh RFID protocol
 #define RFID_MSG_TYPE_NOTIF 0x01
 #define RFID_NOTIF_TYPE_TAG_UPDATE 0x01
+#define RFID_NOTIF_TYPE_LINK_STATS 0x02
 struct rfid_tag_update {
 	uint8_t msgId;
 	uint8_t msgType;
@@ -86,12 +260,21 @@ struct rfid_tag_update {
 	uint8_t itemSize;
 	uint8_t itemCount;
 };
+struct rfid_link_stats_update {
+	uint8_t msgId;
+	uint8_t msgType;
+	uint8_t notifType;
+};
+// Size of the rfid_link_stats_update header struct (in bytes)
+#define RFID_LINK_STATS_UPDATE_SIZE 3 // bytes
+// Size of the link statistics payload (in bytes), six 32 bit counters
+#define RFID_LINK_STATS_SIZE 24 // bytes
 // Buffer to store the SmartMessage payload
 uint8_t _sendBuffer[MOTE_MAX_DATA_SIZE];
 
 // Send an RFID tag update SmartMesh notification to the manager
 // Parameters:
-//   msgId: Unique if for the message
+//   msgId: Unique id for the message
 //   itemSize: Size (in bytes) of each tag
 //   itemCount: Total number of tags in data
 // Returns: true if message is successfully queued for send, false otherwise
@@ -115,6 +298,273 @@ static bool sendRfidTagUpdate(uint8_t msgId, uint16_t itemSize, uint8_t itemCoun
 	return mote_sendData(_sendBuffer, len);
 }
 
+// Write a 32 bit value to a message payload, most significant byte first
+// Parameters:
+//   payload: Payload position to write to
+//   value: Value to write
+// Returns: Payload position after the value
+static uint8_t* putUint32(uint8_t *payload, uint32_t value) {
+	payload[0] = (uint8_t)(value >> 24);
+	payload[1] = (uint8_t)(value >> 16);
+	payload[2] = (uint8_t)(value >> 8);
+	payload[3] = (uint8_t)value;
+	return payload + 4;
+}
+
+// Send an RFID link statistics SmartMesh notification to the manager
+// Parameters:
+//   msgId: Unique id for the message
+//   stats: Link statistics to send
+// Returns: true if message is successfully queued for send, false otherwise
+// Notes: mote_getSendStatus() should be called to determine whether 
+// the message was sent successfully
+static bool sendRfidLinkStats(uint8_t msgId, rfid_link_stats *stats) {
+	// Create message header
+	struct rfid_link_stats_update *msg = (struct rfid_link_stats_update*)_sendBuffer;
+	msg->msgId = msgId;
+	msg->msgType = RFID_MSG_TYPE_NOTIF;
+	msg->notifType = RFID_NOTIF_TYPE_LINK_STATS;
+
+	// Add counters to message payload, most significant byte first
+	uint8_t *payload = &_sendBuffer[RFID_LINK_STATS_UPDATE_SIZE];
+	payload = putUint32(payload, stats->droppedFrames);
+	payload = putUint32(payload, stats->crcFailures);
+	payload = putUint32(payload, stats->resyncBytes);
+	payload = putUint32(payload, stats->ringOverflows);
+	payload = putUint32(payload, stats->decodeFailures);
+	payload = putUint32(payload, stats->commandFailures);
+	uint8_t len = RFID_LINK_STATS_SIZE + RFID_LINK_STATS_UPDATE_SIZE;
+
+	// Send the message across the SmartMesh
+	return mote_sendData(_sendBuffer, len);
+}
+
+#if RFID_READ_ADAPTIVE
+// Check whether the current read has stopped finding new tags
+// Parameters:
+//   currentTimestamp: The current timestamp
+// Returns: true once no new unique tags have been added to the hashset for
+// RFID_READ_QUIET_PERIOD, and the read has run for at least RFID_READ_MIN_TIMEOUT
+static bool readSaturated(uint32_t currentTimestamp) {
+	// A new unique tag was added since the last check
+	if (_hashset.length != _readUniqueCount) {
+		_readUniqueCount = _hashset.length;
+		_readDiscoveryTimestamp = currentTimestamp;
+	}
+
+	return currentTimestamp - _readStartTimestamp >= RFID_READ_MIN_TIMEOUT
+		&& currentTimestamp - _readDiscoveryTimestamp >= RFID_READ_QUIET_PERIOD;
+}
+#endif
+
+#if RFID_STRATEGY_AUTO
+// Select the inventory strategy for the next read
+// Notes: Uses the duplicate ratio and the number of unique tags found by the
+// read that just ended. Large populations answering mostly with duplicates move
+// to single target, single target reads still seeing duplicates move to tag
+// focus, and small populations return to dual target. A single target or tag
+// focus read that finds far fewer tags than the read before is taken to have
+// started with the tags in the wrong target state. Tag focus is then left out
+// until the next dual target read
+static void selectReadStrategy() {
+	rfid_read_stats stats;
+	uint8_t strategy = rfid_getStrategy();
+	uint8_t nextStrategy = strategy;
+	uint16_t tagCount = _hashset.length;
+	uint32_t duplicatePercent = 0;
+
+	rfid_getReadStats(&stats);
+	if (stats.tagReads > 0) {
+		duplicatePercent = (stats.duplicateReads * 100) / stats.tagReads;
+	}
+
+	bool singleTarget = (strategy == RFID_STRATEGY_SINGLE_TARGET || strategy == RFID_STRATEGY_SINGLE_TARGET_REVERSE);
+	bool carryover = (uint32_t)tagCount * 100 < (uint32_t)_strategyLastCount * RFID_STRATEGY_CARRYOVER;
+
+	if (strategy == RFID_STRATEGY_DUAL_TARGET) {
+		if (tagCount >= RFID_STRATEGY_LARGE_POPULATION && duplicatePercent >= RFID_STRATEGY_DUPLICATE_RATIO) {
+			nextStrategy = RFID_STRATEGY_SINGLE_TARGET;
+		}
+	} else if (strategy == RFID_STRATEGY_TAG_FOCUS && carryover) {
+		// Tags read by the last tag focus read were still in B, tag focus only
+		// reads from A to B so go back to single target
+		nextStrategy = RFID_STRATEGY_SINGLE_TARGET;
+		_strategyFocusCarryover = true;
+	} else if (singleTarget && carryover) {
+		// Most tags did not answer, they were in the other target state at the
+		// start of the read: the tags either kept their state since the last
+		// read or returned to A, so change whether reads alternate
+		_strategyAlternate = !_strategyAlternate;
+	} else if (tagCount < RFID_STRATEGY_SMALL_POPULATION) {
+		nextStrategy = RFID_STRATEGY_DUAL_TARGET;
+		_strategyFocusCarryover = false;
+	} else if (singleTarget && !_strategyFocusCarryover && duplicatePercent >= RFID_STRATEGY_DUPLICATE_RATIO) {
+		// Tags are answering again within the read
+		nextStrategy = RFID_STRATEGY_TAG_FOCUS;
+	}
+
+	// Single target reads start from the state the last read left the tags in
+	if (singleTarget && nextStrategy == strategy) {
+		if (_strategyAlternate && strategy == RFID_STRATEGY_SINGLE_TARGET) {
+			nextStrategy = RFID_STRATEGY_SINGLE_TARGET_REVERSE;
+		} else {
+			nextStrategy = RFID_STRATEGY_SINGLE_TARGET;
+		}
+	}
+
+	if (nextStrategy != strategy) {
+		rfid_setStrategy(nextStrategy);
+	}
+	_strategyLastCount = tagCount;
+}
+#endif
+
+#if RFID_THERMAL_CONTROL
+// Adjust the read window and gap to the reader temperature
+// Returns: Time to wait before the next read, RFID_READ_INTERVAL while cool
+// Notes: Samples the temperatures every RFID_THERMAL_SAMPLE_READS reads. The
+// duty cycle drops in proportion to the overshoot above RFID_THERMAL_TARGET
+// and climbs back in small steps once the reader has cooled below the
+// hysteresis margin, so throughput settles at a steady rate the reader can
+// sustain. A sample the reader does not answer leaves the duty cycle as it
+// is, and is taken again after the next read
+static uint32_t scheduleThermal() {
+	rfid_temperature temperature;
+	int32_t hottest;
+	int32_t duty = _thermalDuty;
+	uint32_t gap;
+	uint32_t idle;
+
+	if (_thermalSampleReads > 0) {
+		_thermalSampleReads--;
+	} else if (rfid_getTemperature(&temperature)) {
+		_thermalSampleReads = RFID_THERMAL_SAMPLE_READS - 1;
+		hottest = temperature.pa > temperature.internal ? temperature.pa : temperature.internal;
+
+		if (hottest > RFID_THERMAL_TARGET) {
+			duty -= (hottest - RFID_THERMAL_TARGET) * RFID_THERMAL_STEP_DOWN;
+		} else if (hottest < RFID_THERMAL_TARGET - RFID_THERMAL_HYSTERESIS) {
+			duty += RFID_THERMAL_STEP_UP;
+		}
+		if (duty < RFID_THERMAL_MIN_DUTY) {
+			duty = RFID_THERMAL_MIN_DUTY;
+		} else if (duty > 100) {
+			duty = 100;
+		}
+		_thermalDuty = (uint8_t)duty;
+
+		// Shorten reads in proportion, keeping the reader start up
+		_readWindow = (RFID_READ_DURATION * _thermalDuty) / 100;
+#if RFID_READ_ADAPTIVE
+		if (_readWindow < RFID_READ_MIN_TIMEOUT) {
+			_readWindow = RFID_READ_MIN_TIMEOUT;
+		}
+#endif
+#if RFID_READ_AUTOSTOP
+		rfid_setAutostop(_readWindow, 0, 0);
+#endif
+	}
+
+	// Idle long enough after the last read for it to make up the duty cycle,
+	// less the time already spent transmitting
+	gap = (_readLastDuration * (100 - _thermalDuty)) / _thermalDuty;
+	idle = timer_getTicks() - (_readBeginTimestamp + _readLastDuration);
+	if (gap > idle + RFID_READ_INTERVAL) {
+		return gap - idle;
+	}
+	return RFID_READ_INTERVAL;
+}
+#endif
+
+#if RFID_TX_POWER_CONTROL
+// Select the transmit power for the next read
+// Notes: Tries a lower power while out of zone tags make up a large share of
+// the reads, and raises it while many reads are weak. Otherwise, after
+// RFID_TX_POWER_HOLD_READS reads, a lower power is tried. A lower power is kept
+// only while it finds nearly as many tags as RFID_TX_POWER_MAX, at a rate that
+// still improves the tags per watt. The reference is taken at every read at
+// RFID_TX_POWER_MAX, and refreshed every RFID_TX_POWER_REFRESH_READS reads
+// below it for tags that have come or gone
+static void selectTxPower() {
+	rfid_read_stats stats;
+	uint16_t power = rfid_getTxPower();
+	int32_t nextPower = power;
+	uint16_t tagCount = _hashset.length;
+	uint32_t tagRate = 0;
+	uint32_t outOfZone;
+	bool crowded;
+	bool lost;
+
+	rfid_getReadStats(&stats);
+	outOfZone = stats.filteredReads;
+	crowded = outOfZone * 100 >= (stats.tagReads + outOfZone) * RFID_TX_POWER_OUT_OF_ZONE;
+	if (_readLastDuration > 0) {
+		tagRate = ((uint32_t)tagCount * 1000) / _readLastDuration;
+	}
+	if (_txPowerOutOfZoneHold > 0) {
+		_txPowerOutOfZoneHold--;
+	}
+
+	// Every step down is checked against full power, so the losses of
+	// several steps cannot add up unnoticed
+	if (power >= RFID_TX_POWER_MAX) {
+		_txPowerRefCount = tagCount;
+		_txPowerRefRate = tagRate;
+		_txPowerRefreshReads = RFID_TX_POWER_REFRESH_READS;
+	} else if (_txPowerRefreshReads > 0) {
+		_txPowerRefreshReads--;
+	}
+	lost = (uint32_t)tagCount * 100 < (uint32_t)_txPowerRefCount * RFID_TX_POWER_KEEP_TAGS
+			|| tagRate * 100 < _txPowerRefRate * RFID_TX_POWER_KEEP_RATE;
+
+	if (_txPowerResume > 0) {
+		// Reference refreshed, go back to the power before it
+		nextPower = _txPowerResume;
+		_txPowerResume = 0;
+	} else if (power < RFID_TX_POWER_MAX && lost) {
+		// Go back up, the lower power lost tags or the tags per watt
+		nextPower = power + RFID_TX_POWER_STEP;
+		_txPowerHold = RFID_TX_POWER_HOLD_READS;
+		_txPowerOutOfZoneHold = RFID_TX_POWER_HOLD_READS;
+	} else if (power < RFID_TX_POWER_MAX && _txPowerRefreshReads == 0) {
+		// Refresh the reference, lost tags never show up as weak reads
+		_txPowerResume = power;
+		nextPower = RFID_TX_POWER_MAX;
+	} else if (stats.tagReads == 0 && outOfZone == 0) {
+		// No tags in range, nothing to measure against
+	} else if (crowded && _txPowerOutOfZoneHold == 0) {
+		// Try a lower power to drop the out of zone tags
+		nextPower = power - RFID_TX_POWER_STEP;
+	} else if (stats.weakReads * 100 >= stats.tagReads * RFID_TX_POWER_WEAK_RATIO) {
+		nextPower = power + RFID_TX_POWER_STEP;
+		_txPowerHold = RFID_TX_POWER_HOLD_READS;
+	} else if (_txPowerHold > 0) {
+		_txPowerHold--;
+	} else {
+		// Try a lower power
+		_txPowerHold = RFID_TX_POWER_HOLD_READS;
+		nextPower = power - RFID_TX_POWER_STEP;
+	}
+
+	if (nextPower < RFID_TX_POWER_MIN) {
+		nextPower = RFID_TX_POWER_MIN;
+	} else if (nextPower > RFID_TX_POWER_MAX) {
+		nextPower = RFID_TX_POWER_MAX;
+	}
+	if (nextPower != power) {
+		rfid_setTxPower((uint16_t)nextPower);
+	}
+
+	// Weak reads are counted from the RSSI of each tag. They are only needed
+	// below full power, and for the read that decides a step down from it
+	if (nextPower < RFID_TX_POWER_MAX || _txPowerHold == 0) {
+		rfid_setReportFields(RFID_REPORT_PROFILE | E_IPJ_TAG_FLAG_BIT_RSSI);
+	} else {
+		rfid_setReportFields(RFID_REPORT_PROFILE);
+	}
+}
+#endif
+
 // Transition from one app state to another
 // Parameters:
 //   newState: The app state to transition to
@@ -129,17 +579,52 @@ static void setAppState(uint8_t newState) {
 	if (_appState == APP_STATE_READING_TAGS) {
 		// Stop reading tags
 		rfid_stopRead();
+#if RFID_THERMAL_CONTROL || RFID_TX_POWER_CONTROL
+		_readLastDuration = timer_getTicks() - _readBeginTimestamp;
+#endif
+#if RFID_STRATEGY_AUTO
+		selectReadStrategy();
+#endif
+#if RFID_TX_POWER_CONTROL
+		selectTxPower();
+#endif
 	}
 
 	// Transition to state...
 
 	if (newState == APP_STATE_PENDING_READ) {
 		// Schedule a read
+#if RFID_THERMAL_CONTROL
+		if (_appState == APP_STATE_TRANSMITTING_TAGS) {
+			_nextTimeout = timer_getTicks() + scheduleThermal();
+		} else {
+			_nextTimeout = timer_getTicks() + RFID_READ_INTERVAL;
+		}
+#else
 		_nextTimeout = timer_getTicks() + RFID_READ_INTERVAL;
+#endif
 	} else if (newState == APP_STATE_READING_TAGS) {
 		// Start reading tags
-		_nextTimeout = timer_getTicks() + RFID_READ_TIMEOUT;
+#if RFID_THERMAL_CONTROL || RFID_TX_POWER_CONTROL
+		_readBeginTimestamp = timer_getTicks();
+#endif
+#if RFID_THERMAL_CONTROL
+#if RFID_READ_AUTOSTOP
+		_nextTimeout = _readBeginTimestamp + _readWindow + RFID_READ_AUTOSTOP_MARGIN;
+#else
+		_nextTimeout = _readBeginTimestamp + _readWindow;
+#endif
+#elif RFID_READ_AUTOSTOP
+		_nextTimeout = timer_getTicks() + RFID_READ_DURATION + RFID_READ_AUTOSTOP_MARGIN;
+#else
+		_nextTimeout = timer_getTicks() + RFID_READ_DURATION;
+#endif
 		hashset_reset(&_hashset);
+#if RFID_READ_ADAPTIVE
+		_readStartTimestamp = timer_getTicks();
+		_readDiscoveryTimestamp = _readStartTimestamp;
+		_readUniqueCount = 0;
+#endif
 		rfid_startRead();
 	} else if (newState == APP_STATE_TRANSMITTING_TAGS) {
 		// Initialise hashset iterator
@@ -238,11 +723,41 @@ int main(int argc, char *argv[])
 	// Initialise debug LEDs
 	led_setup();
 
-	// Initialise hashset
+	// Check CRC implementation (including the CRC accelerator, when enabled)
+	ASSERT_RESULT(crc16_selfTest(), 1);
+
+	// Initialise hashset, with the RSSI gate presence state stored for each tag
+#if RFID_RSSI_MIN_READS > 0
+	hashset_initValues(&_hashset, HASHSET_ITEMS, TAG_DATA_SIZE, sizeof(rfid_tag_presence));
+#else
 	hashset_init(&_hashset, HASHSET_ITEMS, TAG_DATA_SIZE);
+#endif
 
 	// Initialise RFID reader
 	rfid_setup(EPC_SIZE, TID_SIZE);
+#if RFID_RSSI_MIN_READS > 0
+	rfid_setRssiGate(RFID_RSSI_THRESHOLD, RFID_RSSI_MIN_READS);
+#endif
+#if RFID_TX_POWER_CONTROL
+	rfid_setTxPower(RFID_TX_POWER_MAX);
+#endif
+#if RFID_TAG_FILTER != RFID_TAG_FILTER_NONE
+	prefixset_init(&_tagFilterPrefixes, RFID_TAG_FILTER_ITEMS, EPC_SIZE);
+	uint8_t prefixIndex;
+	for (prefixIndex = 0; prefixIndex < (sizeof(_tagFilterPrefixItems) / sizeof(_tagFilterPrefixItems[0])); prefixIndex++) {
+		ASSERT_RESULT(prefixset_add(&_tagFilterPrefixes, _tagFilterPrefixItems[prefixIndex].prefix, _tagFilterPrefixItems[prefixIndex].bitLength), PREFIXSET_OK);
+	}
+	rfid_setTagFilter(&_tagFilterPrefixes, RFID_TAG_FILTER);
+#endif
+#if RFID_SELECT_FILTERS
+	uint8_t filterIndex;
+	for (filterIndex = 0; filterIndex < (sizeof(_selectFilters) / sizeof(_selectFilters[0])); filterIndex++) {
+		rfid_setSelectFilter(filterIndex, &_selectFilters[filterIndex]);
+	}
+#endif
+#if RFID_READ_AUTOSTOP
+	rfid_setAutostop(RFID_READ_DURATION, 0, 0);
+#endif
 
 	// Initialise mote
 	mote_init();
@@ -254,11 +769,18 @@ int main(int argc, char *argv[])
 	// Caches current timestamp
 	uint32_t currentTimestamp;
 
+	// Reader frames read since the mesh events were last processed
+	uint16_t frameCount;
+	uint16_t frames;
+
 	// Event loop
 	while (1) {
 		// Process mote events
 		mote_doEvents();
 
+		// Process RFID reader events
+		rfid_doEvents();
+
 		// Fetch the current mote state
 		moteState = mote_getState();
 
@@ -282,18 +804,31 @@ int main(int argc, char *argv[])
 		if (_appState == APP_STATE_PENDING_READ && _nextTimeout < currentTimestamp) {
 			setAppState(APP_STATE_READING_TAGS);
 		} else if (_appState == APP_STATE_READING_TAGS) {
-			if (_nextTimeout < currentTimestamp) {
-				// Timeout reached, start transmit
+			if (_nextTimeout < currentTimestamp || !rfid_isReading()) {
+				// Reader stopped or timeout reached, start transmit
+				setAppState(APP_STATE_TRANSMITTING_TAGS);
+#if RFID_READ_ADAPTIVE
+			} else if (readSaturated(currentTimestamp)) {
+				// No new tags for a while, end the read early and start transmit
 				setAppState(APP_STATE_TRANSMITTING_TAGS);
+#endif
 			} else {
-				// Read next tag
-				rfid_readNext(&_hashset);
+				// Read pending tags, draining a backlog up to the frame limit
+				frameCount = 0;
+				do {
+					frames = rfid_readNext(&_hashset);
+					frameCount += frames;
+				} while (frames == RFID_RECEIVE_FRAME_BUDGET && frameCount < RFID_READ_FRAMES_PER_YIELD);
 			}
 		} else if (_appState == APP_STATE_TRANSMITTING_TAGS && _nextTimeout < currentTimestamp) {
 			if (_lastTransmitOk && mote_getSendStatus() == MOTE_SEND_SUCCESS) {
 				// Prepare next transmit
 				_transmitTagCount = 0;
-				while (hashset_iterate(&_hashsetIterator)) {
+				while (!_transmitLinkStats && hashset_iterate(&_hashsetIterator)) {
+					// Skip tags not read enough times above the RSSI gate
+					if (!rfid_isTagPresent(_hashsetIterator.value)) {
+						continue;
+					}
 					memcpy((void*)&_transmitBuffer[_transmitTagCount++ * TAG_DATA_SIZE], (void*)_hashsetIterator.item, TAG_DATA_SIZE);
 					if (_transmitTagCount >= TRANSMIT_TAG_MAX_ITEMS) {
 						break;
@@ -306,13 +841,28 @@ int main(int argc, char *argv[])
 
 					// Schedule the next send
 					_nextTimeout = timer_getTicks() + TRANSMIT_TAG_UPDATE_INTERVAL;
+				} else if (!_transmitLinkStats && _linkStatsTimeout < currentTimestamp) {
+					// Tags sent, transmit link statistics
+					rfid_getLinkStats(&_linkStats);
+					_transmitLinkStats = true;
+					_transmitMsgId = (_transmitMsgId + 1) % 256;
+					_lastTransmitOk = sendRfidLinkStats(_transmitMsgId, &_linkStats);
+
+					// Schedule the next send and notification
+					_nextTimeout = timer_getTicks() + TRANSMIT_TAG_UPDATE_INTERVAL;
+					_linkStatsTimeout = currentTimestamp + TRANSMIT_LINK_STATS_INTERVAL;
 				} else {
+					_transmitLinkStats = false;
 					setAppState(APP_STATE_PENDING_READ);
 				}
 			} else {
 				if (mote_getSendStatus() != MOTE_SEND_IN_PROGRESS) {
 					// Last transmit failed, try again
-					_lastTransmitOk = sendRfidTagUpdate(_transmitMsgId, TAG_DATA_SIZE, _transmitTagCount, _transmitBuffer);
+					if (_transmitLinkStats) {
+						_lastTransmitOk = sendRfidLinkStats(_transmitMsgId, &_linkStats);
+					} else {
+						_lastTransmitOk = sendRfidTagUpdate(_transmitMsgId, TAG_DATA_SIZE, _transmitTagCount, _transmitBuffer);
+					}
 
 					// Schedule the next send
 					_nextTimeout = timer_getTicks() + TRANSMIT_TAG_UPDATE_INTERVAL;
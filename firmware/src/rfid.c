@@ -7,6 +7,7 @@
 #include <platform.h>
 #include <drivers/gpio/adi_gpio.h>
 #include <hashset.h>
+#include <prefixset.h>
 
 #include "timer.h"
 #include "assert.h"
@@ -18,10 +19,45 @@
 // Interval to delay between reset toggles
 #define RFID_RESET_TIME 150 // milliseconds
 
+// Maximum number of reader configuration entries
+#define RFID_CONFIG_MAX_ENTRIES 32 // entries
+// Maximum number of key values sent in a single bulk set
+#define RFID_CONFIG_BATCH_SIZE 16 // entries
+// Set to 1 to skip waiting for bulk set responses when applying configuration
+#define RFID_CONFIG_SUPPRESS_RESPONSES 0
+
+// Number of failed start or stop commands in a row after which the module is
+// reset, a single failure is retried by the next rfid_startRead()
+#define RFID_COMMAND_MAX_FAILURES 2 // commands
+
+// Number of entries in the antenna sequence, shared out between the antennas
+// by the new tags each antenna finds
+#define RFID_ANTENNA_SEQUENCE_SIZE 16 // entries
+#if RFID_ANTENNA_COUNT > RFID_ANTENNA_SEQUENCE_SIZE
+#error "RFID_ANTENNA_COUNT must not be more than RFID_ANTENNA_SEQUENCE_SIZE"
+#endif
+
+// Set to 1 to have the reader report the TID with the EPC during inventory
+// (FastID) when a TID size is set. The TID bank read is only enabled while
+// tags without FastID support are being read
+#define RFID_FAST_ID 1
+
+// Set to 1 to set the reader's tag population hint before each inventory,
+// estimated from the tag reads of the previous inventory
+#define RFID_POPULATION_ESTIMATE 1
+// Maximum tag population hint
+#define RFID_POPULATION_MAX 1024 // tags
+// Fixed point one, for the population estimate
+#define RFID_POPULATION_ONE (1ULL << 30)
+
 // RFID device memory
 static ipj_iri_device iri_device = { 0 };
 // Flag for monitoring if RFID is reading
-static uint32_t ipj_stopped_flag;
+static uint32_t ipj_stopped_flag = 1;
+// Flag for a stop sent to the reader that has not been reported yet
+static bool stopRequested = false;
+// Number of failed start or stop commands in a row
+static uint8_t commandFailures = 0;
 
 // Expected EPC size
 static uint16_t expectedEpcSize = 0;
@@ -31,6 +67,115 @@ static uint16_t expectedTidSize = 0;
 static hashset *resultHashset = 0;
 // Buffer for storing tag data
 static uint8_t tagBuffer[128];
+#if RFID_ANTENNA_COUNT > 1
+// Antenna counters for the current read, indexed by antenna number - 1
+static rfid_antenna_stats antennaStats[RFID_ANTENNA_COUNT];
+// Antenna sequence entries given to each antenna
+static uint8_t antennaSlots[RFID_ANTENNA_COUNT];
+// Smoothed new tags found by each antenna per full antenna sequence, x16
+static uint32_t antennaYield[RFID_ANTENNA_COUNT];
+// Antenna sequence for the reader
+static ipj_key_list antennaSequence;
+// Flag for an antenna sequence change not yet sent to the reader
+static bool antennaSequenceChanged = false;
+
+static void rfid_updateAntennaSequence();
+#endif
+#if RFID_FAST_ID
+// Number of tag reports without a FastID TID in the current read
+static uint32_t fastIdMissedReads = 0;
+#endif
+// Minimum RSSI of a tag read, for the RSSI gate
+static int32_t rssiGateThreshold = 0;
+// Number of reads above the RSSI gate before a tag is present, 0 for no gate
+static uint8_t rssiGateMinReads = 0;
+// Report fields requested by rfid_setReportFields()
+static ipj_tag_flag reportFields = RFID_REPORT_PROFILE;
+// EPC prefixes for the host tag filter
+static prefixset *tagFilterPrefixes = 0;
+// Host tag filter policy
+static uint8_t tagFilterPolicy = RFID_TAG_FILTER_NONE;
+
+// Tag read counters for the current read
+static rfid_read_stats readStats;
+// Current inventory strategy
+static uint8_t currentStrategy = RFID_STRATEGY_DEFAULT;
+// Current transmit power
+static uint16_t currentTxPower = RFID_TX_POWER;
+#if RFID_POPULATION_ESTIMATE
+// Inventory strategy of the current read
+static uint8_t readStrategy = RFID_STRATEGY_DEFAULT;
+// Smoothed tag population estimate, 0 until tags have been read
+static uint32_t populationEstimate = 0;
+#endif
+
+// Reader link health counters
+static rfid_link_stats linkStats;
+// Receive buffer overflow count when the counters were reset
+static uint32_t ringOverflowBase = 0;
+
+// Reader configuration key
+typedef struct {
+	ipj_key key;
+	uint32_t value;
+} rfid_config_value;
+
+// Reader configuration entry, with the value last applied to the reader
+typedef struct {
+	ipj_key key;
+	uint32_t bankIndex;
+	uint32_t valueIndex;
+	uint32_t value;
+	uint32_t appliedValue;
+	bool applied;
+} rfid_config_entry;
+
+// Base reader configuration, applied by rfid_setup
+static const rfid_config_value baseConfig[] =
+{
+	{ E_IPJ_KEY_REGION_ID,          RFID_REGION },
+	{ E_IPJ_KEY_ANTENNA_TX_POWER,   RFID_TX_POWER },
+	{ E_IPJ_KEY_RF_MODE,            RFID_RF_MODE },
+};
+
+// Gen2 session and target preset for an inventory strategy
+typedef struct {
+	ipj_select_target session;
+	ipj_inventory_search_mode searchMode;
+	ipj_inventory_select_flag selectFlag;
+	bool tagFocus;
+} rfid_strategy_preset;
+
+// Inventory strategy presets, indexed by RFID_STRATEGY_*
+static const rfid_strategy_preset strategyPresets[] =
+{
+	{ RFID_STRATEGY_DUAL_SESSION,     E_IPJ_INVENTORY_SEARCH_MODE_DUAL_TARGET,          E_IPJ_INVENTORY_SELECT_FLAG_ALL_SL, false },
+	{ RFID_STRATEGY_SINGLE_SESSION,   E_IPJ_INVENTORY_SEARCH_MODE_SINGLE_TARGET_A_TO_B, E_IPJ_INVENTORY_SELECT_FLAG_ALL_SL, false },
+	{ RFID_STRATEGY_SINGLE_SESSION,   E_IPJ_INVENTORY_SEARCH_MODE_SINGLE_TARGET_B_TO_A, E_IPJ_INVENTORY_SELECT_FLAG_ALL_SL, false },
+	// Tag focus refreshes the S1 flags of read tags while they are energised
+	{ E_IPJ_SELECT_TARGET_SESSION_S1, E_IPJ_INVENTORY_SEARCH_MODE_SINGLE_TARGET_A_TO_B, E_IPJ_INVENTORY_SELECT_FLAG_ALL_SL, true },
+};
+
+// Reader Select filters
+static rfid_select_filter selectFilters[RFID_SELECT_MAX_FILTERS];
+// Flags for the Select filters that are set
+static bool selectFilterSet[RFID_SELECT_MAX_FILTERS];
+// Number of reader Select operations enabled by the last rfid_applySelectFilters()
+static uint8_t selectAppliedCount = 0;
+// Flag for Select filter changes not yet sent to the reader
+static bool selectChanged = false;
+// Key list for the Select mask currently being sent
+static ipj_key_list selectMaskList;
+
+// Reader configuration table
+static rfid_config_entry configTable[RFID_CONFIG_MAX_ENTRIES];
+// Number of entries in the reader configuration table
+static uint8_t configCount = 0;
+// Key values for the bulk set currently being built
+static ipj_key_value configBatch[RFID_CONFIG_BATCH_SIZE];
+
+static void rfid_applySelectFilters();
+static void rfid_receive(uint32_t *frameCount);
 
 // Impinj SDK Platform handlers
 struct ipj_handler {
@@ -49,11 +194,20 @@ static struct ipj_handler event_handlers[] =
 	{ E_IPJ_HANDLER_TYPE_PLATFORM_FLUSH_PORT,       &platform_flush_port_handler },
 };
 
+// Fold a read into the smoothed RSSI of a tag
+// Parameters:
+//   presence: Presence state stored with the tag
+//   rssi: RSSI of the read, dBm x 100
+static inline void rfid_smoothRssi(rfid_tag_presence *presence, int32_t rssi) {
+	presence->rssi += (int16_t)((rssi - presence->rssi) / 4);
+}
+
 // Impinj SDK tag report handler
-ipj_error ipj_util_tag_operation_report_handler(ipj_iri_device* iri_device, ipj_tag_operation_report* tag_operation_report) {
+// EPC and TID fields point directly into the IRI receive buffer
+ipj_error ipj_util_tag_report_handler(ipj_iri_device* iri_device, ipj_tag_report_view* tag_report) {
 	// Check for error
-	if (tag_operation_report->has_error && tag_operation_report->error > 0) {
-		return tag_operation_report->error;
+	if (tag_report->has_error && tag_report->error > 0) {
+		return tag_report->error;
 	}
 
 	// If hashset isn't initialised then ignore tag read
@@ -61,36 +215,101 @@ ipj_error ipj_util_tag_operation_report_handler(ipj_iri_device* iri_device, ipj_
 		return E_IPJ_ERROR_SUCCESS;
 	}
 
-	bool hasEpc = false;
-	bool hasTid = false;
 	uint8_t addResult;
+	uint8_t *key;
+	uint8_t *value;
+	bool weak;
 
 	// Check if tag has EPC
-	if (tag_operation_report->tag.has_epc && tag_operation_report->tag.epc.size == expectedEpcSize) {
-		hasEpc = true;
+	if (!tag_report->has_epc || tag_report->epc_size != expectedEpcSize) {
+		return E_IPJ_ERROR_SUCCESS;
+	}
+
+	// Drop tags rejected by the host tag filter before they take a hashset slot
+	if (tagFilterPolicy != RFID_TAG_FILTER_NONE
+			&& prefixset_match(tagFilterPrefixes, tag_report->epc) != (tagFilterPolicy == RFID_TAG_FILTER_ALLOW)) {
+		readStats.filteredReads++;
+		return E_IPJ_ERROR_SUCCESS;
+	}
+
+	// Reads below the RSSI gate, such as reflections from far away tags
+	weak = rssiGateMinReads > 0 && (!tag_report->has_rssi || tag_report->rssi < rssiGateThreshold);
+
+	if (expectedTidSize == 0) {
+		// EPC only, use straight from the report
+		key = (uint8_t*)tag_report->epc;
+	} else {
+		const uint8_t *tid = 0;
+
+#if RFID_FAST_ID
+		// Check if tag has a FastID TID, reported with the EPC
+		if (tag_report->has_tid && tag_report->tid_size == expectedTidSize) {
+			tid = tag_report->tid;
+		} else if (!weak) {
+			fastIdMissedReads++;
+		}
+#endif
+
+		// Check if tag has a TID read from the TID bank
+		if (tid == 0 && tag_report->has_tag_operation_type && tag_report->tag_operation_type == E_IPJ_TAG_OPERATION_TYPE_READ
+				&& tag_report->has_tag_operation_data && tag_report->tag_operation_data_size == expectedTidSize) {
+			tid = tag_report->tag_operation_data;
+		}
+
+		if (tid == 0) {
+			return E_IPJ_ERROR_SUCCESS;
+		}
+
+		// Combined EPC/TID
+		memcpy(tagBuffer, tag_report->epc, tag_report->epc_size);
+		memcpy(tagBuffer + tag_report->epc_size, tid, expectedTidSize);
+		key = tagBuffer;
 	}
 
-	// Check if tag has TID
-	if (expectedTidSize > 0 && tag_operation_report->has_tag_operation_type && tag_operation_report->tag_operation_type == E_IPJ_TAG_OPERATION_TYPE_READ) {
-		if (tag_operation_report->has_tag_operation_data && tag_operation_report->tag_operation_data.size == expectedTidSize) {
-			hasTid = true;
+	// Weak reads don't take a hashset slot, but lower the smoothed RSSI of a
+	// tag already read above the gate
+	if (weak) {
+		readStats.gatedReads++;
+		if (tag_report->has_rssi && hashset_findValue(resultHashset, key, &value)) {
+			rfid_smoothRssi((rfid_tag_presence*)value, tag_report->rssi);
 		}
+		return E_IPJ_ERROR_SUCCESS;
 	}
 
-	if (hasEpc && (expectedTidSize == 0 || hasTid)) {
-		if (expectedTidSize == 0) {
-			// EPC only
-			addResult = hashset_add(resultHashset, tag_operation_report->tag.epc.bytes);
-			ASSERT_RESULT(addResult != HASHSET_TABLE_FULL, true);
+	addResult = hashset_addValue(resultHashset, key, &value);
+	ASSERT_RESULT(addResult != HASHSET_TABLE_FULL, true);
+
+	// Update the presence state stored with the tag
+	if (rssiGateMinReads > 0) {
+		rfid_tag_presence *presence = (rfid_tag_presence*)value;
+		if (presence->reads == 0) {
+			presence->rssi = (int16_t)tag_report->rssi;
 		} else {
-			// Combined EPC/TID
-			memcpy(tagBuffer, tag_operation_report->tag.epc.bytes, tag_operation_report->tag.epc.size);
-			memcpy(tagBuffer + tag_operation_report->tag.epc.size, tag_operation_report->tag_operation_data.bytes, tag_operation_report->tag_operation_data.size);
+			rfid_smoothRssi(presence, tag_report->rssi);
+		}
+		if (presence->reads < 255) {
+			presence->reads++;
+		}
+	}
+
+	// Count the read, for the inventory strategy and transmit power selection
+	readStats.tagReads++;
+	if (addResult == HASHSET_ITEM_EXISTS) {
+		readStats.duplicateReads++;
+	}
+	if (tag_report->has_rssi && tag_report->rssi < RFID_RSSI_WEAK) {
+		readStats.weakReads++;
+	}
 
-			addResult = hashset_add(resultHashset, tagBuffer);
-			ASSERT_RESULT(addResult != HASHSET_TABLE_FULL, true);
+#if RFID_ANTENNA_COUNT > 1
+	// Count the read against its antenna, for the antenna sequence
+	if (tag_report->has_antenna && tag_report->antenna >= 1 && tag_report->antenna <= RFID_ANTENNA_COUNT) {
+		antennaStats[tag_report->antenna - 1].tagReads++;
+		if (addResult == HASHSET_OK) {
+			antennaStats[tag_report->antenna - 1].newTags++;
 		}
 	}
+#endif
 
 	return E_IPJ_ERROR_SUCCESS;
 }
@@ -107,9 +326,6 @@ ipj_error ipj_util_report_handler(ipj_iri_device* iri_device, ipj_report_id repo
 
 	switch (report_id)
 	{
-		case E_IPJ_REPORT_ID_TAG_OPERATION_REPORT:
-			error = ipj_util_tag_operation_report_handler(iri_device, (ipj_tag_operation_report*) report);
-			break;
 		case E_IPJ_REPORT_ID_STOP_REPORT:
 			error = ipj_util_stop_report_handler(iri_device, (ipj_stop_report*) report);
 			break;
@@ -121,6 +337,61 @@ ipj_error ipj_util_report_handler(ipj_iri_device* iri_device, ipj_report_id repo
 	return error;
 }
 
+// Impinj SDK diagnostic handler
+// Counts link errors detected by the IRI library
+void ipj_util_diagnostic_handler(ipj_iri_device* iri_device, ipj_error error) {
+	switch (error)
+	{
+		case E_IPJ_ERROR_IRI_FRAME_DROPPED:
+			linkStats.droppedFrames++;
+			break;
+		case E_IPJ_ERROR_IRI_FRAME_INVALID:
+			linkStats.crcFailures++;
+			break;
+		case E_IPJ_ERROR_IRI_FRAME_SYNC_SKIPPED:
+			linkStats.resyncBytes++;
+			break;
+		case E_IPJ_ERROR_COMMAND_DECODE_FAILURE:
+			linkStats.decodeFailures++;
+			break;
+	}
+}
+
+// Impinj SDK command complete handler
+// Called from ipj_receive when an asynchronous command completes
+// Notes: A failed command leaves the reader idle as far as the read is
+// concerned, so the current read ends and the next rfid_startRead() retries,
+// or resets the module after RFID_COMMAND_MAX_FAILURES failures in a row
+void ipj_util_command_complete_handler(ipj_iri_device* iri_device, ipj_error error) {
+	if (error == E_IPJ_ERROR_SUCCESS) {
+		commandFailures = 0;
+		return;
+	}
+
+	// A stop that crosses with the inventory ending by itself, such as by
+	// autostop, is rejected by the reader that is already idle
+	if (stopRequested && ipj_stopped_flag) {
+		return;
+	}
+
+	commandFailures++;
+	linkStats.commandFailures++;
+	ipj_stopped_flag = 1;
+	stopRequested = false;
+}
+
+// Reset the RFID module by toggling its enable pin
+static void rfid_reset() {
+	ADI_GPIO_RESULT eGpioResult;
+
+	eGpioResult = adi_gpio_SetLow(RFID_ENABLE_PORT, RFID_ENABLE_PIN);
+	ASSERT_RESULT(eGpioResult, ADI_GPIO_SUCCESS);
+	timer_sleepMs(RFID_RESET_TIME);
+	eGpioResult = adi_gpio_SetHigh(RFID_ENABLE_PORT, RFID_ENABLE_PIN);
+	ASSERT_RESULT(eGpioResult, ADI_GPIO_SUCCESS);
+	timer_sleepMs(RFID_RESET_TIME);
+}
+
 // Setup RFID module
 // Parameters:
 //   epcSize: Expected size, in bytes, of the EPC
@@ -139,12 +410,7 @@ void rfid_setup(uint16_t epcSize, uint16_t tidSize) {
 	ASSERT_RESULT(eGpioResult, ADI_GPIO_SUCCESS);
 
 	// Reset RFID module
-	eGpioResult = adi_gpio_SetLow(RFID_ENABLE_PORT, RFID_ENABLE_PIN);
-	ASSERT_RESULT(eGpioResult, ADI_GPIO_SUCCESS);
-	timer_sleepMs(RFID_RESET_TIME);
-	eGpioResult = adi_gpio_SetHigh(RFID_ENABLE_PORT, RFID_ENABLE_PIN);
-	ASSERT_RESULT(eGpioResult, ADI_GPIO_SUCCESS);
-	timer_sleepMs(RFID_RESET_TIME);
+	rfid_reset();
 
 	// Setup Impinj SDK
 	eIpjError = ipj_initialize_iri_device(&iri_device);
@@ -164,75 +430,810 @@ void rfid_setup(uint16_t epcSize, uint16_t tidSize) {
 	// Register non-platform event handlers
 	eIpjError = ipj_register_handler(&iri_device, E_IPJ_HANDLER_TYPE_REPORT, (void*)&ipj_util_report_handler);
 	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+	eIpjError = ipj_register_handler(&iri_device, E_IPJ_HANDLER_TYPE_TAG_REPORT, (void*)&ipj_util_tag_report_handler);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+	eIpjError = ipj_register_handler(&iri_device, E_IPJ_HANDLER_TYPE_DIAGNOSTIC, (void*)&ipj_util_diagnostic_handler);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+	eIpjError = ipj_register_handler(&iri_device, E_IPJ_HANDLER_TYPE_COMMAND_COMPLETE, (void*)&ipj_util_command_complete_handler);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
 
 	// Open UART and initialise Impinj SDK
 	eIpjError = ipj_connect(&iri_device, NULL, E_IPJ_CONNECTION_TYPE_SERIAL, NULL);
 	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
 
-	// Configure module region
-	eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_REGION_ID, RFID_REGION);
-	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+	// Reader is idle until the first rfid_startRead()
+	ipj_stopped_flag = 1;
+	stopRequested = false;
 
-	// Configure module transmit power
-	eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_ANTENNA_TX_POWER, RFID_TX_POWER);
-	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+	// Reset link health counters
+	memset(&linkStats, 0, sizeof(linkStats));
+	ringOverflowBase = platform_rx_overflow_count();
+
+	// Module has been reset, nothing has been applied yet
+	configCount = 0;
+	selectAppliedCount = 0;
+	selectChanged = true;
+
+	// Configure module region, transmit power and read mode
+	for (i = 0; i < (sizeof(baseConfig) / sizeof(baseConfig[0])); i++) {
+		rfid_setConfig(baseConfig[i].key, baseConfig[i].value);
+	}
 
-	// Configure read mode (Dense Reader Mode profile for ETSI operation)
-	eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_RF_MODE, 2);
-	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
-	
 	if (tidSize > 0) {
+#if RFID_FAST_ID
+		// Configure reader to report the TID with the EPC
+		rfid_setConfig(E_IPJ_KEY_FAST_ID_ENABLE, true);
+#endif
 		// Configure reader to read TID memory bank
-		eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_TAG_OPERATION_ENABLE, true);
-		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
-		eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_TAG_OPERATION, E_IPJ_TAG_OPERATION_TYPE_READ);
-		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
-		eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_READ_MEM_BANK, E_IPJ_MEM_BANK_TID);
-		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
-		eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_READ_WORD_POINTER, 0x00);
-		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
-		eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_READ_WORD_COUNT, tidSize / 2);
-		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+		rfid_setConfig(E_IPJ_KEY_TAG_OPERATION_ENABLE, true);
+		rfid_setConfig(E_IPJ_KEY_TAG_OPERATION, E_IPJ_TAG_OPERATION_TYPE_READ);
+		rfid_setConfig(E_IPJ_KEY_READ_MEM_BANK, E_IPJ_MEM_BANK_TID);
+		rfid_setConfig(E_IPJ_KEY_READ_WORD_POINTER, 0x00);
+		rfid_setConfig(E_IPJ_KEY_READ_WORD_COUNT, tidSize / 2);
 	} else  {
 		// Configure reader to ignore TID memory bank
-		eIpjError = ipj_set_value(&iri_device, E_IPJ_KEY_TAG_OPERATION_ENABLE, false);
+		rfid_setConfig(E_IPJ_KEY_TAG_OPERATION_ENABLE, false);
+#if RFID_FAST_ID
+		rfid_setConfig(E_IPJ_KEY_FAST_ID_ENABLE, false);
+#endif
+	}
+
+	// Configure report fields, with the fields needed by the TID, antenna and RSSI options
+	rfid_setReportFields(reportFields);
+
+	// Configure inventory session and target
+	rfid_setStrategy(currentStrategy);
+
+#if RFID_ANTENNA_COUNT > 1
+#if RFID_ANTENNA_MUX
+	// Configure external antenna mux
+	rfid_setConfig(E_IPJ_KEY_EXTERNAL_ANTENNA_MUX_ENABLE, true);
+	rfid_setConfig(E_IPJ_KEY_EXTERNAL_ANTENNA_MUX_NUM_ANTENNAS, RFID_ANTENNA_COUNT);
+	rfid_setConfig(E_IPJ_KEY_EXTERNAL_ANTENNA_MUX_PHYSICAL_PORT, RFID_ANTENNA_MUX_PORT);
+	rfid_setConfig(E_IPJ_KEY_EXTERNAL_ANTENNA_MUX_DELAY_MICROSECONDS, RFID_ANTENNA_MUX_DELAY);
+#endif
+
+	// Configure antenna sequence, antennas start with equal shares
+	memset(antennaYield, 0, sizeof(antennaYield));
+	memset(antennaSlots, 0, sizeof(antennaSlots));
+	rfid_updateAntennaSequence();
+	antennaSequenceChanged = true;
+#endif
+
+	// Send the configuration to the reader
+	rfid_applyConfig();
+}
+
+// Set a reader configuration value
+// Parameters:
+//   key: Key code to set
+//   value: Value to set
+// Notes: The value is sent to the reader by the next rfid_applyConfig()
+void rfid_setConfig(ipj_key key, uint32_t value) {
+	rfid_setConfigIndexed(key, 0, 0, value);
+}
+
+// Set a reader configuration value for a key with banks or lists
+// Parameters:
+//   key: Key code to set
+//   bankIndex: Bank of the key to set
+//   valueIndex: Index of the value to set
+//   value: Value to set
+// Notes: The value is sent to the reader by the next rfid_applyConfig()
+void rfid_setConfigIndexed(ipj_key key, uint32_t bankIndex, uint32_t valueIndex, uint32_t value) {
+	uint8_t i;
+
+	// Update an existing entry
+	for (i = 0; i < configCount; i++) {
+		if (configTable[i].key == key && configTable[i].bankIndex == bankIndex && configTable[i].valueIndex == valueIndex) {
+			configTable[i].value = value;
+			return;
+		}
+	}
+
+	// Add a new entry
+	ASSERT_RESULT(configCount < RFID_CONFIG_MAX_ENTRIES, true);
+	configTable[configCount].key = key;
+	configTable[configCount].bankIndex = bankIndex;
+	configTable[configCount].valueIndex = valueIndex;
+	configTable[configCount].value = value;
+	configTable[configCount].applied = false;
+	configCount++;
+}
+
+// Send a batch of configuration values to the reader
+// Parameters:
+//   count: Number of values in configBatch
+//   keyList: Key list to send with the values, or NULL for none
+static void rfid_sendConfigBatch(uint8_t count, ipj_key_list *keyList) {
+	ipj_error eIpjError;
+
+#if RFID_CONFIG_SUPPRESS_RESPONSES
+	eIpjError = ipj_suppress_set_responses(&iri_device);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+#endif
+
+	eIpjError = ipj_bulk_set(&iri_device, configBatch, count, keyList, keyList ? 1 : 0);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+
+#if RFID_CONFIG_SUPPRESS_RESPONSES
+	eIpjError = ipj_resume_set_responses(&iri_device);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+#endif
+}
+
+// Send changed configuration values to the reader
+// Notes: Values already applied to the reader are not sent again
+void rfid_applyConfig() {
+	uint8_t i;
+	uint8_t count = 0;
+
+	for (i = 0; i < configCount; i++) {
+		if (configTable[i].applied && configTable[i].appliedValue == configTable[i].value) {
+			continue;
+		}
+
+		configBatch[count].key = configTable[i].key;
+		configBatch[count].bank_index = configTable[i].bankIndex;
+		configBatch[count].value_index = configTable[i].valueIndex;
+		configBatch[count].value = configTable[i].value;
+		count++;
+
+		configTable[i].appliedValue = configTable[i].value;
+		configTable[i].applied = true;
+
+		// Batch full, send it
+		if (count == RFID_CONFIG_BATCH_SIZE) {
+			rfid_sendConfigBatch(count, NULL);
+			count = 0;
+		}
+	}
+
+	if (count > 0) {
+		rfid_sendConfigBatch(count, NULL);
+	}
+
+	if (selectChanged) {
+		rfid_applySelectFilters();
+	}
+
+#if RFID_ANTENNA_COUNT > 1
+	if (antennaSequenceChanged) {
+		rfid_sendConfigBatch(0, &antennaSequence);
+		antennaSequenceChanged = false;
+	}
+#endif
+}
+
+// Add a Select filter key value to configBatch
+// Parameters:
+//   count: Number of values already in configBatch
+//   key: Key code to set
+//   selectIndex: Reader Select operation the key belongs to
+//   value: Value to set
+// Returns: Number of values in configBatch
+static uint8_t rfid_addSelectValue(uint8_t count, ipj_key key, uint8_t selectIndex, uint32_t value) {
+	configBatch[count].key = key;
+	configBatch[count].bank_index = selectIndex;
+	configBatch[count].value_index = 0;
+	configBatch[count].value = value;
+	return count + 1;
+}
+
+// Send the Select filters to the reader
+// Notes: Include filters are sent before exclude filters, so that an exclude
+// filter overrides any include filter. Each filter is a bulk set of its key
+// values with the mask as a key list
+static void rfid_applySelectFilters() {
+	uint8_t pass;
+	uint8_t i;
+	uint8_t j;
+	uint8_t count;
+	uint8_t selectIndex = 0;
+	bool haveInclude = false;
+
+	for (i = 0; i < RFID_SELECT_MAX_FILTERS; i++) {
+		if (selectFilterSet[i] && selectFilters[i].action == RFID_SELECT_INCLUDE) {
+			haveInclude = true;
+		}
+	}
+
+	for (pass = RFID_SELECT_INCLUDE; pass <= RFID_SELECT_EXCLUDE; pass++) {
+		for (i = 0; i < RFID_SELECT_MAX_FILTERS; i++) {
+			const rfid_select_filter *filter = &selectFilters[i];
+			ipj_select_action action;
+
+			if (!selectFilterSet[i] || filter->action != pass) {
+				continue;
+			}
+
+			// The first Select sets the SL flag of every tag, later ones only change matching tags
+			if (pass == RFID_SELECT_INCLUDE) {
+				action = (selectIndex == 0) ? E_IPJ_SELECT_ACTION_ASLINVA_DSLINVB : E_IPJ_SELECT_ACTION_ASLINVA_NOTHING;
+			} else {
+				action = (selectIndex == 0 && !haveInclude) ? E_IPJ_SELECT_ACTION_DSLINVB_ASLINVA : E_IPJ_SELECT_ACTION_DSLINVB_NOTHING;
+			}
+
+			count = 0;
+			count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_ENABLE, selectIndex, true);
+			count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_TARGET, selectIndex, E_IPJ_SELECT_TARGET_SL_FLAG);
+			count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_ACTION, selectIndex, action);
+			count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_MEM_BANK, selectIndex, filter->memBank);
+			count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_POINTER, selectIndex, filter->pointer);
+			count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_MASK_LENGTH, selectIndex, filter->maskLength);
+
+			// Mask bits are packed into words, most significant bit first
+			memset(&selectMaskList, 0, sizeof(selectMaskList));
+			selectMaskList.key = E_IPJ_KEY_SELECT_MASK_VALUE;
+			selectMaskList.bank_index = selectIndex;
+			selectMaskList.list_count = (filter->maskLength + 31) / 32;
+			for (j = 0; j < (filter->maskLength + 7) / 8; j++) {
+				selectMaskList.list[j / 4] |= (uint32_t)filter->mask[j] << (24 - 8 * (j % 4));
+			}
+
+			rfid_sendConfigBatch(count, &selectMaskList);
+			selectIndex++;
+		}
+	}
+
+	// Disable Select operations left over from earlier filters
+	count = 0;
+	for (i = selectIndex; i < selectAppliedCount; i++) {
+		count = rfid_addSelectValue(count, E_IPJ_KEY_SELECT_ENABLE, i, false);
+	}
+	if (count > 0) {
+		rfid_sendConfigBatch(count, NULL);
+	}
+
+	selectAppliedCount = selectIndex;
+	selectChanged = false;
+}
+
+// Set the fields the reader includes in each tag report
+// Parameters:
+//   fields: Combination of E_IPJ_TAG_FLAG_BIT_* values, see RFID_REPORT_*
+void rfid_setReportFields(ipj_tag_flag fields) {
+	reportFields = fields;
+
+	// The RSSI gate needs the RSSI of each tag
+	if (rssiGateMinReads > 0) {
+		fields |= E_IPJ_TAG_FLAG_BIT_RSSI;
+	}
+#if RFID_FAST_ID
+	// FastID TIDs are reported in the TID field
+	if (expectedTidSize > 0) {
+		fields |= E_IPJ_TAG_FLAG_BIT_TID;
+	}
+#endif
+#if RFID_ANTENNA_COUNT > 1
+	// Antenna statistics need the antenna of each tag
+	fields |= E_IPJ_TAG_FLAG_BIT_ANTENNA;
+#endif
+	rfid_setConfig(E_IPJ_KEY_REPORT_CONTROL_TAG, fields);
+}
+
+// Set the reader to end each inventory by itself
+// Parameters:
+//   durationMs: Inventory duration, or 0 for no time limit
+//   tagCount: Number of tag reads to stop after, or 0 for no limit
+//   roundCount: Number of inventory rounds to stop after, or 0 for no limit
+void rfid_setAutostop(uint32_t durationMs, uint32_t tagCount, uint32_t roundCount) {
+	rfid_setConfig(E_IPJ_KEY_AUTOSTOP_DURATION_MS, durationMs);
+	rfid_setConfig(E_IPJ_KEY_AUTOSTOP_TAG_COUNT, tagCount);
+	rfid_setConfig(E_IPJ_KEY_AUTOSTOP_ROUND_COUNT, roundCount);
+}
+
+// Get the inventory select flag
+// Parameters:
+//   presetFlag: Select flag of the inventory strategy
+// Returns: presetFlag, or the SL flag set by the Select filters when any filter is set
+static ipj_inventory_select_flag rfid_selectFlag(ipj_inventory_select_flag presetFlag) {
+	uint8_t i;
+
+	for (i = 0; i < RFID_SELECT_MAX_FILTERS; i++) {
+		if (selectFilterSet[i]) {
+			return E_IPJ_INVENTORY_SELECT_FLAG_SL;
+		}
+	}
+
+	return presetFlag;
+}
+
+// Set the inventory strategy
+// Parameters:
+//   strategy: Strategy to use, see RFID_STRATEGY_*
+void rfid_setStrategy(uint8_t strategy) {
+	ASSERT_RESULT(strategy < (sizeof(strategyPresets) / sizeof(strategyPresets[0])), true);
+
+	const rfid_strategy_preset *preset = &strategyPresets[strategy];
+	rfid_setConfig(E_IPJ_KEY_INVENTORY_SESSION, preset->session);
+	rfid_setConfig(E_IPJ_KEY_INVENTORY_SEARCH_MODE, preset->searchMode);
+	rfid_setConfig(E_IPJ_KEY_INVENTORY_SELECT_FLAG, rfid_selectFlag(preset->selectFlag));
+	rfid_setConfig(E_IPJ_KEY_TAG_FOCUS_ENABLE, preset->tagFocus);
+
+	currentStrategy = strategy;
+}
+
+// Get the inventory strategy
+// Returns: Strategy set by the last rfid_setStrategy(), see RFID_STRATEGY_*
+uint8_t rfid_getStrategy() {
+	return currentStrategy;
+}
+
+// Set the transmit power
+// Parameters:
+//   power: Transmit power, dBm x 100
+void rfid_setTxPower(uint16_t power) {
+	rfid_setConfig(E_IPJ_KEY_ANTENNA_TX_POWER, power);
+	currentTxPower = power;
+}
+
+// Get the transmit power
+// Returns: Power set by the last rfid_setTxPower(), dBm x 100
+uint16_t rfid_getTxPower() {
+	return currentTxPower;
+}
+
+// Set a reader Select filter
+// Parameters:
+//   index: Filter to set, less than RFID_SELECT_MAX_FILTERS
+//   filter: Filter to apply
+void rfid_setSelectFilter(uint8_t index, const rfid_select_filter *filter) {
+	ASSERT_RESULT(index < RFID_SELECT_MAX_FILTERS, true);
+	ASSERT_RESULT(filter->maskLength <= RFID_SELECT_MASK_SIZE * 8, true);
+	ASSERT_RESULT(filter->action <= RFID_SELECT_EXCLUDE, true);
+
+	selectFilters[index] = *filter;
+	selectFilterSet[index] = true;
+	selectChanged = true;
+
+	// Only tags with the SL flag set by the filters take part in inventory
+	rfid_setConfig(E_IPJ_KEY_INVENTORY_SELECT_FLAG, E_IPJ_INVENTORY_SELECT_FLAG_SL);
+}
+
+// Clear a reader Select filter
+// Parameters:
+//   index: Filter to clear, less than RFID_SELECT_MAX_FILTERS
+void rfid_clearSelectFilter(uint8_t index) {
+	ASSERT_RESULT(index < RFID_SELECT_MAX_FILTERS, true);
+
+	if (!selectFilterSet[index]) {
+		return;
+	}
+
+	selectFilterSet[index] = false;
+	selectChanged = true;
+
+	// Return to the strategy's select flag once no filters are left
+	rfid_setConfig(E_IPJ_KEY_INVENTORY_SELECT_FLAG, rfid_selectFlag(strategyPresets[currentStrategy].selectFlag));
+}
+
+// Set the RSSI gate
+// Parameters:
+//   threshold: Minimum RSSI of a tag read, dBm x 100
+//   minReads: Number of reads above threshold before a tag is present, or 0
+//             for no gate
+void rfid_setRssiGate(int32_t threshold, uint8_t minReads) {
+	rssiGateThreshold = threshold;
+	rssiGateMinReads = minReads;
+
+	// Update the report fields for the gate
+	rfid_setReportFields(reportFields);
+}
+
+// Check whether a tag read into a hashset is present
+// Parameters:
+//   value: Value stored with the tag in the hashset
+// Returns: true if the tag has been read enough times above the RSSI gate
+//          and its smoothed RSSI is still above the gate, or there is no gate
+bool rfid_isTagPresent(const uint8_t *value) {
+	const rfid_tag_presence *presence = (const rfid_tag_presence*)value;
+	return rssiGateMinReads == 0 || (presence->reads >= rssiGateMinReads && presence->rssi >= rssiGateThreshold);
+}
+
+// Set the host tag filter
+// Parameters:
+//   prefixes: EPC prefixes to check each tag against, with keys of the
+//             expected EPC size, or 0 for no filter
+//   policy: How matching tags are treated, see RFID_TAG_FILTER_*
+void rfid_setTagFilter(prefixset *prefixes, uint8_t policy) {
+	ASSERT_RESULT(policy <= RFID_TAG_FILTER_DENY, true);
+	ASSERT_RESULT(prefixes == 0 || prefixes->keySize == expectedEpcSize, true);
+
+	tagFilterPrefixes = prefixes;
+	tagFilterPolicy = (prefixes == 0) ? RFID_TAG_FILTER_NONE : policy;
+}
+
+// Receive pending reader frames
+// Parameters:
+//   frameCount: Set to the number of frames processed, may be NULL
+static void rfid_receive(uint32_t *frameCount) {
+	ipj_error eIpjError = ipj_receive_budget(&iri_device, RFID_RECEIVE_FRAME_BUDGET, frameCount);
+
+	// Corrupt frames are counted by the diagnostic handler and skipped
+	if (eIpjError != E_IPJ_ERROR_IRI_FRAME_INVALID && eIpjError != E_IPJ_ERROR_COMMAND_DECODE_FAILURE) {
 		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
 	}
 }
 
+#if RFID_ANTENNA_COUNT > 1
+// Share the antenna sequence out between the antennas
+// Notes: Each antenna keeps at least one entry, so antennas that have found
+// nothing are still checked for new tags. The other entries go to the
+// antennas in proportion to the new tags they have been finding, and are
+// interleaved so every antenna is visited throughout the read
+static void rfid_updateAntennaSequence() {
+	uint8_t slots[RFID_ANTENNA_COUNT];
+	int32_t current[RFID_ANTENNA_COUNT];
+	uint32_t totalYield = 0;
+	uint8_t remaining = RFID_ANTENNA_SEQUENCE_SIZE;
+	uint8_t best;
+	uint8_t i;
+	uint8_t entry;
+
+	// Update the yield of each antenna from the last read, per full sequence
+	for (i = 0; i < RFID_ANTENNA_COUNT; i++) {
+		if (antennaSlots[i] > 0) {
+			uint32_t yield = (antennaStats[i].newTags << 4) * RFID_ANTENNA_SEQUENCE_SIZE / antennaSlots[i];
+			antennaYield[i] = (antennaYield[i] + yield) / 2;
+		}
+		totalYield += antennaYield[i];
+	}
+
+	// One entry each, the rest by yield or equally when nothing has been found
+	for (i = 0; i < RFID_ANTENNA_COUNT; i++) {
+		slots[i] = 1;
+	}
+	remaining -= RFID_ANTENNA_COUNT;
+	if (totalYield > 0) {
+		uint8_t shared = remaining;
+		for (i = 0; i < RFID_ANTENNA_COUNT; i++) {
+			uint8_t share = (uint8_t)(((uint32_t)shared * antennaYield[i]) / totalYield);
+			slots[i] += share;
+			remaining -= share;
+		}
+	}
+	// Entries left over from rounding go to the highest yield antennas
+	for (i = 0; remaining > 0; i = (i + 1) % RFID_ANTENNA_COUNT, remaining--) {
+		if (totalYield > 0) {
+			best = 0;
+			for (entry = 1; entry < RFID_ANTENNA_COUNT; entry++) {
+				if (antennaYield[entry] * slots[best] > antennaYield[best] * slots[entry]) {
+					best = entry;
+				}
+			}
+			slots[best]++;
+		} else {
+			slots[i]++;
+		}
+	}
+
+	// Interleave the entries, smooth weighted round robin
+	memset(current, 0, sizeof(current));
+	for (entry = 0; entry < RFID_ANTENNA_SEQUENCE_SIZE; entry++) {
+		best = 0;
+		for (i = 0; i < RFID_ANTENNA_COUNT; i++) {
+			current[i] += slots[i];
+			if (current[i] > current[best]) {
+				best = i;
+			}
+		}
+		current[best] -= RFID_ANTENNA_SEQUENCE_SIZE;
+
+		if (antennaSequence.list[entry] != (uint32_t)(best + 1)) {
+			antennaSequence.list[entry] = best + 1;
+			antennaSequenceChanged = true;
+		}
+	}
+	antennaSequence.key = E_IPJ_KEY_ANTENNA_SEQUENCE;
+	antennaSequence.list_count = RFID_ANTENNA_SEQUENCE_SIZE;
+
+	memcpy(antennaSlots, slots, sizeof(antennaSlots));
+}
+#endif
+
+#if RFID_POPULATION_ESTIMATE
+// Get the expected number of unique tags after a number of reads from a
+// population of equally likely tags, population * (1 - (1 - 1/population)^reads)
+// Parameters:
+//   population: Number of tags in the field
+//   reads: Number of tag reads
+// Returns: Expected number of unique tags read
+static uint32_t rfid_expectedUnique(uint32_t population, uint32_t reads) {
+	uint64_t base = ((uint64_t)(population - 1) << 30) / population;
+	uint64_t missed = RFID_POPULATION_ONE;
+
+	// Fixed point power, by squaring
+	while (reads > 0) {
+		if (reads & 1) {
+			missed = (missed * base) >> 30;
+		}
+		base = (base * base) >> 30;
+		reads >>= 1;
+	}
+
+	return (uint32_t)((population * (RFID_POPULATION_ONE - missed)) >> 30);
+}
+
+// Estimate the tag population from a dual target read
+// Parameters:
+//   reads: Number of tag reads
+//   unique: Number of unique tags read
+// Returns: Smallest population expected to give at least the unique tags seen
+// Notes: Tags are read again in every round of a dual target read, so the
+// share of repeated reads shows how many tags were not seen
+static uint32_t rfid_estimatePopulation(uint32_t reads, uint32_t unique) {
+	uint32_t low = unique;
+	uint32_t high = unique * 4;
+
+	if (high > RFID_POPULATION_MAX) {
+		high = RFID_POPULATION_MAX;
+	}
+	if (low >= high) {
+		return low;
+	}
+
+	while (low < high) {
+		uint32_t mid = (low + high) / 2;
+		if (rfid_expectedUnique(mid, reads) >= unique) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+	return low;
+}
+
+// Set the reader's tag population hint from the tag reads of the last inventory
+// Notes: The hint is rounded to a power of two, the reader starts each round
+// with a Q of about log2 of the hint, so smaller changes are not sent
+static void rfid_updatePopulation() {
+	uint32_t unique = readStats.tagReads - readStats.duplicateReads;
+	uint32_t estimate = unique;
+	uint32_t hint = 1;
+
+	// Nothing read yet, keep the reader default
+	if (readStats.tagReads == 0 && populationEstimate == 0) {
+		return;
+	}
+
+	if (readStrategy == RFID_STRATEGY_DUAL_TARGET && unique > 0) {
+		estimate = rfid_estimatePopulation(readStats.tagReads, unique);
+	}
+
+	// Tags dropped by the host tag filter still answer the reader
+	if (readStats.tagReads > 0) {
+		estimate += (uint32_t)(((uint64_t)estimate * readStats.filteredReads) / readStats.tagReads);
+	}
+	if (estimate > RFID_POPULATION_MAX) {
+		estimate = RFID_POPULATION_MAX;
+	}
+
+	// Follow increases at once, decreases over a few reads
+	if (estimate >= populationEstimate) {
+		populationEstimate = estimate;
+	} else {
+		populationEstimate -= (populationEstimate - estimate + 3) / 4;
+	}
+
+	while (hint * 2 <= populationEstimate) {
+		hint *= 2;
+	}
+	if (populationEstimate * 2 >= hint * 3) {
+		hint *= 2;
+	}
+
+	rfid_setConfig(E_IPJ_KEY_INVENTORY_TAG_POPULATION, hint);
+}
+#endif
+
+// Reset the module after commands have failed
+// Notes: The configuration table, Select filters and antenna sequence are
+// sent again by the next rfid_applyConfig()
+static void rfid_recover() {
+	ipj_error eIpjError;
+	uint8_t i;
+
+	eIpjError = ipj_disconnect(&iri_device);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+	rfid_reset();
+	eIpjError = ipj_connect(&iri_device, NULL, E_IPJ_CONNECTION_TYPE_SERIAL, NULL);
+	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+
+	for (i = 0; i < configCount; i++) {
+		configTable[i].applied = false;
+	}
+	selectAppliedCount = 0;
+	selectChanged = true;
+#if RFID_ANTENNA_COUNT > 1
+	antennaSequenceChanged = true;
+#endif
+
+	ipj_stopped_flag = 1;
+	stopRequested = false;
+	commandFailures = 0;
+}
+
+// Wait for an inventory stopped by rfid_stopRead() to report that it stopped
+// Notes: Resets the module if the stop is not reported, or after
+// RFID_COMMAND_MAX_FAILURES failed commands in a row
+static void rfid_waitForStop() {
+	uint32_t timeout = timer_getTicks() + IPJ_DEFAULT_RECEIVE_TIMEOUT_MS;
+	while (stopRequested && !ipj_stopped_flag) {
+		if (timer_getTicks() >= timeout) {
+			commandFailures = RFID_COMMAND_MAX_FAILURES;
+			linkStats.commandFailures++;
+			break;
+		}
+		rfid_receive(NULL);
+	}
+	stopRequested = false;
+
+	if (commandFailures >= RFID_COMMAND_MAX_FAILURES) {
+		rfid_recover();
+	}
+}
+
 // Start scanning for RFID tags
 void rfid_startRead() {
 	resultHashset = 0;
 
+	// Wait for the previous inventory to report that it stopped
+	rfid_waitForStop();
+
+#if RFID_POPULATION_ESTIMATE
+	// Update the population hint from the last read
+	rfid_updatePopulation();
+	readStrategy = currentStrategy;
+#endif
+
+#if RFID_FAST_ID
+	// Read the TID bank only while the last read saw tags without FastID support
+	if (expectedTidSize > 0) {
+		if (fastIdMissedReads > 0) {
+			rfid_setConfig(E_IPJ_KEY_TAG_OPERATION_ENABLE, true);
+		} else if (readStats.tagReads > 0) {
+			rfid_setConfig(E_IPJ_KEY_TAG_OPERATION_ENABLE, false);
+		}
+		fastIdMissedReads = 0;
+	}
+#endif
+
+#if RFID_ANTENNA_COUNT > 1
+	// Reweight the antenna sequence from the last read
+	rfid_updateAntennaSequence();
+	memset(antennaStats, 0, sizeof(antennaStats));
+#endif
+
+	// Reset tag read counters
+	memset(&readStats, 0, sizeof(readStats));
+
+	// Send any configuration changes
+	rfid_applyConfig();
+
 	// Clear the stopped flag
 	ipj_stopped_flag = 0;
 
-	ipj_error eIpjError = ipj_start(&iri_device, E_IPJ_ACTION_INVENTORY);
+	// Start without waiting, the response is handled by rfid_readNext()
+	ipj_error eIpjError = ipj_start_async(&iri_device, E_IPJ_ACTION_INVENTORY);
 	ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
 }
 
-// Read the next RFID tag into a hashset
+// Check whether the reader is still scanning for RFID tags
+// Returns: false once the reader has reported that inventory stopped
+bool rfid_isReading() {
+	return !ipj_stopped_flag;
+}
+
+// Read pending RFID tags into a hashset
 // Parameters:
 //   h: Hashset to add the tag data to
-void rfid_readNext(hashset *h) {
+// Returns: Number of reader frames processed, RFID_RECEIVE_FRAME_BUDGET
+//          if more data is likely pending
+uint16_t rfid_readNext(hashset *h) {
+	uint32_t frameCount = 0;
+
 	if (!ipj_stopped_flag) {
+		// The RSSI gate stores presence state with each tag
+		ASSERT_RESULT(rssiGateMinReads == 0 || h->valueSize >= sizeof(rfid_tag_presence), true);
 		resultHashset = h;
 
-		// Call ipj_receive to process tag reports
-		ipj_error eIpjError = ipj_receive(&iri_device);
-		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+		// Drain pending tag reports, up to the frame budget
+		rfid_receive(&frameCount);
 	}
 
 	resultHashset = 0;
+
+	return (uint16_t)frameCount;
 }
 
 // Stop scanning for RFID tags
 void rfid_stopRead() {
-	// Stop inventory if it is still running
-	if (!ipj_stopped_flag) {
-		ipj_error eIpjError = ipj_stop(&iri_device, E_IPJ_ACTION_INVENTORY);
+	// Stop inventory if it is still running, without waiting for the response
+	if (!ipj_stopped_flag && !stopRequested) {
+		ipj_error eIpjError = ipj_stop_async(&iri_device, E_IPJ_ACTION_INVENTORY);
 		ASSERT_RESULT(eIpjError, E_IPJ_ERROR_SUCCESS);
+		stopRequested = true;
 	}
 
 	resultHashset = 0;
 }
+
+// Process RFID reader events
+// Notes: Completes commands sent by rfid_startRead() and rfid_stopRead(),
+// should be called regularly from the main loop
+void rfid_doEvents() {
+	// Drain responses and the reports that follow a stop
+	if (ipj_command_pending(&iri_device) || (stopRequested && !ipj_stopped_flag)) {
+		rfid_receive(NULL);
+	}
+}
+
+// Get the reader link health counters
+// Parameters:
+//   stats: Counters to fill in, counted since rfid_setup()
+void rfid_getLinkStats(rfid_link_stats *stats) {
+	*stats = linkStats;
+	stats->ringOverflows = platform_rx_overflow_count() - ringOverflowBase;
+}
+
+// Get the tag read counters
+// Parameters:
+//   stats: Counters to fill in, counted since rfid_startRead()
+void rfid_getReadStats(rfid_read_stats *stats) {
+	*stats = readStats;
+}
+
+// Get the antenna counters
+// Parameters:
+//   antenna: Antenna number, 1 to RFID_ANTENNA_COUNT
+//   stats: Counters to fill in, counted since rfid_startRead()
+void rfid_getAntennaStats(uint8_t antenna, rfid_antenna_stats *stats) {
+	ASSERT_RESULT(antenna >= 1 && antenna <= RFID_ANTENNA_COUNT, true);
+
+#if RFID_ANTENNA_COUNT > 1
+	*stats = antennaStats[antenna - 1];
+	stats->sequenceSlots = antennaSlots[antenna - 1];
+#else
+	// Single antenna, every read is from the default antenna
+	stats->tagReads = readStats.tagReads;
+	stats->newTags = readStats.tagReads - readStats.duplicateReads;
+	stats->sequenceSlots = 1;
+#endif
+}
+
+// Read the reader temperatures
+// Parameters:
+//   temperature: Temperatures to fill in
+// Returns: true if the temperatures were read, false if the reader did not
+//          answer
+// Notes: Waits for a stopping inventory to end, call between reads
+bool rfid_getTemperature(rfid_temperature *temperature) {
+	ipj_error eIpjError;
+
+	// Let a pending stop complete before sending another command
+	rfid_waitForStop();
+
+	// Read all the temperatures in one request
+	configBatch[0].key = E_IPJ_KEY_TEMPERATURE_PA;
+	configBatch[1].key = E_IPJ_KEY_TEMPERATURE_INTERNAL;
+	configBatch[0].bank_index = configBatch[1].bank_index = 0;
+	configBatch[0].value_index = configBatch[1].value_index = 0;
+	eIpjError = ipj_bulk_get(&iri_device, configBatch, 2, NULL, 0);
+
+	// A failed read is counted like a failed start or stop, the caller skips
+	// the sample and repeated failures reset the module
+	if (eIpjError != E_IPJ_ERROR_SUCCESS) {
+		commandFailures++;
+		linkStats.commandFailures++;
+		if (commandFailures >= RFID_COMMAND_MAX_FAILURES) {
+			rfid_recover();
+		}
+		return false;
+	}
+	commandFailures = 0;
+
+	temperature->pa = (int32_t)configBatch[0].value;
+	temperature->internal = (int32_t)configBatch[1].value;
+	return true;
+}
@@ -6,14 +6,126 @@
 #define RFID_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include <hashset.h>
+#include <prefixset.h>
 #include <iri.h>
 
 // RFID region
 #define RFID_REGION 		E_IPJ_REGION_ETSI_EN_302_208_V1_4_1
-// RFID transmit power
+// RFID transmit power, dBm x 100
 #define RFID_TX_POWER		2300
+// RFID read mode (Dense Reader Mode profile for ETSI operation)
+#define RFID_RF_MODE		2
+// Number of antennas to read from, 1 for the default antenna
+#define RFID_ANTENNA_COUNT	1
+// Set to 1 when the antennas are connected through an external antenna mux
+#define RFID_ANTENNA_MUX	0
+// Reader antenna port the external antenna mux is connected to
+#define RFID_ANTENNA_MUX_PORT	E_IPJ_ANTENNA_1
+// Settling delay after the external antenna mux switches antenna
+#define RFID_ANTENNA_MUX_DELAY	100 // microseconds
+
+// Maximum number of reader frames to process per call to rfid_readNext
+#define RFID_RECEIVE_FRAME_BUDGET	16 // frames
+
+// RFID tag report profiles, fields included in each tag report
+// Frame size of a tag report with a 12 byte EPC, including 12 bytes of IRI
+// framing, and the resulting limit on tag reports per second at 115200 baud:
+//   PC, XPC, CRC, timestamp, RSSI, phase, channel, antenna: 57 bytes, 202/s
+//   RFID_REPORT_EPC_RSSI: 35 bytes, 329/s
+//   RFID_REPORT_EPC: 32 bytes, 360/s
+#define RFID_REPORT_EPC			(E_IPJ_TAG_FLAG_BIT_EPC)
+#define RFID_REPORT_EPC_RSSI	(E_IPJ_TAG_FLAG_BIT_EPC | E_IPJ_TAG_FLAG_BIT_RSSI)
+// RFID tag report profile used by default
+#define RFID_REPORT_PROFILE		RFID_REPORT_EPC
+// Reads below this RSSI are counted as weak, close to the reader sensitivity
+#define RFID_RSSI_WEAK			-7000 // dBm x 100
+
+// RFID inventory strategies, Gen2 session and target presets
+// Dual target: tags are read again in every round, for continuous monitoring of small populations
+#define RFID_STRATEGY_DUAL_TARGET				0
+// Single target: each tag answers once then stays quiet, to read large populations once
+#define RFID_STRATEGY_SINGLE_TARGET				1
+// Single target, reading back tags left in the B state by a previous single target read
+#define RFID_STRATEGY_SINGLE_TARGET_REVERSE		2
+// Single target with tag focus, keeps read tags quiet for the whole of a long read
+#define RFID_STRATEGY_TAG_FOCUS					3
+// RFID inventory strategy used by default
+#define RFID_STRATEGY_DEFAULT		RFID_STRATEGY_DUAL_TARGET
+// Gen2 session used by the dual target strategy
+#define RFID_STRATEGY_DUAL_SESSION		E_IPJ_SELECT_TARGET_SESSION_S1
+// Gen2 session used by the single target strategies, S2 or S3 keep their flags between rounds
+#define RFID_STRATEGY_SINGLE_SESSION	E_IPJ_SELECT_TARGET_SESSION_S2
+
+// Maximum number of reader Select filters
+#define RFID_SELECT_MAX_FILTERS		4
+// Maximum size, in bytes, of a Select filter mask
+#define RFID_SELECT_MASK_SIZE		12
+// Bit pointer to the start of the EPC in the EPC memory bank
+#define RFID_SELECT_EPC_POINTER		0x20
+// Select filter actions
+// Include: tags matching the filter take part in inventory
+#define RFID_SELECT_INCLUDE		0
+// Exclude: tags matching the filter do not take part in inventory
+#define RFID_SELECT_EXCLUDE		1
+
+// Reader link health counters
+typedef struct {
+	uint32_t droppedFrames;		// Frames missed, from gaps in the frame sync count
+	uint32_t crcFailures;		// Frames discarded with a bad checksum
+	uint32_t resyncBytes;		// Bytes skipped while searching for a frame header
+	uint32_t ringOverflows;		// Bytes lost to receive buffer overflows
+	uint32_t decodeFailures;	// Frames that could not be decoded
+	uint32_t commandFailures;	// Reader commands that failed or timed out
+} rfid_link_stats;
+
+// Reader temperatures
+typedef struct {
+	int32_t pa;					// Power amplifier temperature, degrees C
+	int32_t internal;			// Internal temperature, degrees C
+} rfid_temperature;
+
+// Host tag filter policies, for EPC prefixes checked before deduplication
+// All tags are kept
+#define RFID_TAG_FILTER_NONE	0
+// Only tags with an EPC matching a prefix are kept
+#define RFID_TAG_FILTER_ALLOW	1
+// Tags with an EPC matching a prefix are dropped
+#define RFID_TAG_FILTER_DENY	2
+
+// Reader Select filter, a tag matches when the maskLength bits of memBank
+// starting at bit pointer are equal to mask (most significant bit first)
+typedef struct {
+	ipj_mem_bank memBank;				// Memory bank to match
+	uint32_t pointer;					// Bit pointer to the first bit to match
+	uint8_t maskLength;					// Number of bits to match
+	uint8_t mask[RFID_SELECT_MASK_SIZE];	// Bits to match
+	uint8_t action;						// RFID_SELECT_INCLUDE or RFID_SELECT_EXCLUDE
+} rfid_select_filter;
+
+// Presence state stored with each hashset entry, for the RSSI gate
+typedef struct {
+	int16_t rssi;				// Smoothed RSSI of the reads since the first above the gate, dBm x 100
+	uint8_t reads;				// Number of reads above the gate, stops at 255
+} rfid_tag_presence;
+
+// Antenna counters for the current read
+typedef struct {
+	uint32_t tagReads;			// Tag reports added to the hashset from the antenna
+	uint32_t newTags;			// Tags first read by the antenna
+	uint8_t sequenceSlots;		// Antenna sequence entries given to the antenna
+} rfid_antenna_stats;
+
+// Tag read counters for the current read
+typedef struct {
+	uint32_t tagReads;			// Tag reports added to the hashset
+	uint32_t duplicateReads;	// Tag reports already in the hashset
+	uint32_t filteredReads;		// Tag reports dropped by the host tag filter
+	uint32_t gatedReads;		// Tag reports dropped by the RSSI gate
+	uint32_t weakReads;			// Tag reports added with an RSSI below RFID_RSSI_WEAK
+} rfid_read_stats;
 
 // Setup RFID module
 // Parameters:
@@ -21,15 +133,149 @@
 //   tidSize: Expected size, in bytes, of the TID
 void rfid_setup(uint16_t epcSize, uint16_t tidSize);
 
+// Set a reader configuration value
+// Parameters:
+//   key: Key code to set
+//   value: Value to set
+// Notes: The value is sent to the reader by the next rfid_applyConfig()
+void rfid_setConfig(ipj_key key, uint32_t value);
+
+// Set a reader configuration value for a key with banks or lists
+// Parameters:
+//   key: Key code to set
+//   bankIndex: Bank of the key to set
+//   valueIndex: Index of the value to set
+//   value: Value to set
+// Notes: The value is sent to the reader by the next rfid_applyConfig()
+void rfid_setConfigIndexed(ipj_key key, uint32_t bankIndex, uint32_t valueIndex, uint32_t value);
+
+// Send changed configuration values to the reader
+// Notes: Values already applied to the reader are not sent again
+void rfid_applyConfig();
+
+// Set the fields the reader includes in each tag report
+// Parameters:
+//   fields: Combination of E_IPJ_TAG_FLAG_BIT_* values, see RFID_REPORT_*
+// Notes: Takes effect from the next rfid_startRead(). When tidSize is set the
+// TID (FastID, or tag operation data) is reported regardless of the profile
+void rfid_setReportFields(ipj_tag_flag fields);
+
+// Set the reader to end each inventory by itself
+// Parameters:
+//   durationMs: Inventory duration, or 0 for no time limit
+//   tagCount: Number of tag reads to stop after, or 0 for no limit
+//   roundCount: Number of inventory rounds to stop after, or 0 for no limit
+// Notes: Takes effect from the next rfid_startRead(). rfid_isReading()
+// returns false once the reader has stopped
+void rfid_setAutostop(uint32_t durationMs, uint32_t tagCount, uint32_t roundCount);
+
+// Set the inventory strategy
+// Parameters:
+//   strategy: Strategy to use, see RFID_STRATEGY_*
+// Notes: Takes effect from the next rfid_startRead()
+void rfid_setStrategy(uint8_t strategy);
+
+// Get the inventory strategy
+// Returns: Strategy set by the last rfid_setStrategy(), see RFID_STRATEGY_*
+uint8_t rfid_getStrategy();
+
+// Set the transmit power
+// Parameters:
+//   power: Transmit power, dBm x 100
+// Notes: Takes effect from the next rfid_startRead()
+void rfid_setTxPower(uint16_t power);
+
+// Get the transmit power
+// Returns: Power set by the last rfid_setTxPower(), dBm x 100
+uint16_t rfid_getTxPower();
+
+// Set a reader Select filter
+// Parameters:
+//   index: Filter to set, less than RFID_SELECT_MAX_FILTERS
+//   filter: Filter to apply
+// Notes: Takes effect from the next rfid_startRead(). When any filter is set,
+// only tags matching an include filter (or, with only exclude filters, any
+// tag) and no exclude filter take part in inventory
+void rfid_setSelectFilter(uint8_t index, const rfid_select_filter *filter);
+
+// Clear a reader Select filter
+// Parameters:
+//   index: Filter to clear, less than RFID_SELECT_MAX_FILTERS
+// Notes: Takes effect from the next rfid_startRead()
+void rfid_clearSelectFilter(uint8_t index);
+
+// Set the host tag filter
+// Parameters:
+//   prefixes: EPC prefixes to check each tag against, with keys of the
+//             expected EPC size, or 0 for no filter
+//   policy: How matching tags are treated, see RFID_TAG_FILTER_*
+// Notes: Tags are checked before they are added to the hashset. Prefixes
+// can be added or removed between calls to rfid_readNext()
+void rfid_setTagFilter(prefixset *prefixes, uint8_t policy);
+
+// Set the RSSI gate
+// Parameters:
+//   threshold: Minimum RSSI of a tag read, dBm x 100
+//   minReads: Number of reads above threshold before a tag is present, or 0
+//             for no gate
+// Notes: Reads below the threshold are not added to the hashset, but lower the
+// smoothed RSSI of a tag already in it. With a gate set, hashsets passed to rfid_readNext() must store a
+// value of sizeof(rfid_tag_presence) with each item, see hashset_initValues()
+void rfid_setRssiGate(int32_t threshold, uint8_t minReads);
+
+// Check whether a tag read into a hashset is present
+// Parameters:
+//   value: Value stored with the tag in the hashset
+// Returns: true if the tag has been read enough times above the RSSI gate
+//          and its smoothed RSSI is still above the gate, or there is no gate
+bool rfid_isTagPresent(const uint8_t *value);
+
 // Start scanning for RFID tags
 void rfid_startRead();
 
-// Read the next RFID tag into a hashset
+// Check whether the reader is still scanning for RFID tags
+// Returns: false once the reader has reported that inventory stopped
+bool rfid_isReading();
+
+// Read pending RFID tags into a hashset
 // Parameters:
 //   h: Hashset to add the tag data to
-void rfid_readNext(hashset *h);
+// Returns: Number of reader frames processed, RFID_RECEIVE_FRAME_BUDGET
+//          if more data is likely pending
+uint16_t rfid_readNext(hashset *h);
 
 // Stop scanning for RFID tags
+// Notes: Returns without waiting for the reader, rfid_doEvents() completes the stop
 void rfid_stopRead();
 
+// Process RFID reader events
+// Notes: Completes commands sent by rfid_startRead() and rfid_stopRead(),
+// should be called regularly from the main loop
+void rfid_doEvents();
+
+// Get the reader link health counters
+// Parameters:
+//   stats: Counters to fill in, counted since rfid_setup()
+void rfid_getLinkStats(rfid_link_stats *stats);
+
+// Get the antenna counters
+// Parameters:
+//   antenna: Antenna number, 1 to RFID_ANTENNA_COUNT
+//   stats: Counters to fill in, counted since rfid_startRead()
+void rfid_getAntennaStats(uint8_t antenna, rfid_antenna_stats *stats);
+
+// Get the tag read counters
+// Parameters:
+//   stats: Counters to fill in, counted since rfid_startRead()
+void rfid_getReadStats(rfid_read_stats *stats);
+
+// Read the reader temperatures
+// Parameters:
+//   temperature: Temperatures to fill in
+// Returns: true if the temperatures were read, false if the reader did not
+//          answer
+// Notes: Waits for a stopping inventory to end, call between reads. The
+// module is reset after RFID_COMMAND_MAX_FAILURES failed commands in a row
+bool rfid_getTemperature(rfid_temperature *temperature);
+
 #endif /* RFID_H_ */
@@ -0,0 +1,641 @@
+#!/usr/bin/env python3
+"""
+Generate specialised nanopb decoders and encoders for IRI messages.
+
+The nanopb interpreter walks a pb_field_t table for every field of every
+message. This script reads the same tables from the generated
+messages.pb.c (and the struct layouts from messages.pb.h) and emits one
+straight-line decode and/or encode function per message, plus a lookup
+table keyed on the field table pointer so iri.c can pick the specialised
+codec and fall back to pb_decode()/pb_encode() for anything else.
+
+A generated decoder returns false on any input it does not handle exactly
+like the interpreter (for example a known field on an unexpected wire
+type), so callers can rewind the stream and retry with pb_decode().
+
+Usage (from firmware/):
+    python3 tools/pb_fastgen.py lib/itk/PbMessages/messages.pb.h \\
+        lib/itk/PbMessages/messages.pb.c -o lib/itk/PbMessages/messages_fast
+
+Regenerate whenever the PbMessages sources are updated.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Messages exchanged during a read cycle. Submessages are pulled in as needed.
+DEFAULT_DECODE = [
+    "BulkSetResponse",
+    "BulkGetResponse",
+    "StartResponse",
+    "ResumeResponse",
+    "StopResponse",
+    "TagOperationReport",
+    "StopReport",
+    "StatusReport",
+    "ErrorReport",
+]
+
+DEFAULT_ENCODE = [
+    "BulkSetCommand",
+    "BulkGetCommand",
+    "StartCommand",
+    "ResumeCommand",
+    "StopCommand",
+]
+
+WIRE_TYPES = {
+    "VARINT": "PB_WT_VARINT",
+    "SVARINT": "PB_WT_VARINT",
+    "FIXED32": "PB_WT_32BIT",
+    "FIXED64": "PB_WT_64BIT",
+    "BYTES": "PB_WT_STRING",
+    "SUBMESSAGE": "PB_WT_STRING",
+}
+
+WIRE_TYPE_VALUES = {
+    "PB_WT_VARINT": 0,
+    "PB_WT_64BIT": 1,
+    "PB_WT_STRING": 2,
+    "PB_WT_32BIT": 5,
+}
+
+PACKABLE = ("VARINT", "SVARINT", "FIXED32", "FIXED64")
+
+
+class Field(object):
+    def __init__(self, tag, htype, ltype, name, size_name, ptr):
+        self.tag = tag
+        self.htype = htype
+        self.ltype = ltype
+        self.name = name
+        self.size_name = size_name
+        self.ptr = ptr
+        self.ctype = None
+
+    @property
+    def submessage(self):
+        return self.ptr[1:-len("_fields")] if self.ltype == "SUBMESSAGE" else None
+
+    @property
+    def default(self):
+        if self.ptr and self.ltype != "SUBMESSAGE":
+            return self.ptr[1:]
+        return None
+
+    @property
+    def wire_type(self):
+        return WIRE_TYPES[self.ltype]
+
+    @property
+    def is_64bit(self):
+        return self.ctype in ("uint64_t", "int64_t")
+
+
+def parse_structs(header):
+    structs = {}
+    pattern = re.compile(r"typedef struct\s*\{(.*?)\}\s*(\w+);", re.S)
+    for body, name in pattern.findall(header):
+        members = {}
+        for line in body.splitlines():
+            m = re.match(r"\s*([\w ]+?)\s+(\w+)(\[\d+\])?;", line)
+            if m:
+                members[m.group(2)] = m.group(1)
+        structs[name] = members
+    return structs
+
+
+def parse_tables(source):
+    tables = {}
+    pattern = re.compile(
+        r"const pb_field_t (\w+)_fields\[\d+\] = \{(.*?)PB_LAST_FIELD\s*\};", re.S)
+    for name, body in pattern.findall(source):
+        fields = []
+        for entry in re.split(r"\n\s*\n", body.strip()):
+            m = re.search(
+                r"\{(\d+), \(pb_type_t\) \(\(int32_t\) PB_HTYPE_(\w+) \| "
+                r"\(int32_t\) PB_LTYPE_(\w+)\),\s*(?:offsetof|pb_delta_end)"
+                r"\(\w+, (\w+)[,)].*?pb_delta\(\w+, (\w+), \w+\).*?"
+                r"(&\w+|0)\},?\s*$", entry, re.S)
+            if not m:
+                sys.exit("cannot parse field entry in %s_fields:\n%s" % (name, entry))
+            tag, htype, ltype, fname, size_name, ptr = m.groups()
+            if htype not in ("OPTIONAL", "ARRAY"):
+                sys.exit("%s.%s: PB_HTYPE_%s is not supported" % (name, fname, htype))
+            if ltype not in WIRE_TYPES:
+                sys.exit("%s.%s: PB_LTYPE_%s is not supported" % (name, fname, ltype))
+            if htype == "ARRAY" and ltype == "BYTES":
+                sys.exit("%s.%s: repeated bytes are not supported" % (name, fname))
+            fields.append(Field(int(tag), htype, ltype, fname, size_name,
+                                ptr if ptr != "0" else None))
+        tables[name] = fields
+    return tables
+
+
+def key(field, wire_type=None):
+    return "(%d << 3) | %s" % (field.tag, wire_type or field.wire_type)
+
+
+def key_size(field, wire_type=None):
+    value = (field.tag << 3) | WIRE_TYPE_VALUES[wire_type or field.wire_type]
+    size = 1
+    while value > 0x7F:
+        value >>= 7
+        size += 1
+    return size
+
+
+def varint_value(field, expr):
+    return "(uint64_t) %s" % expr if field.is_64bit else "(uint32_t) %s" % expr
+
+
+class Writer(object):
+    def __init__(self):
+        self.lines = []
+
+    def __call__(self, text="", indent=0):
+        self.lines.append(("    " * indent + text).rstrip())
+
+    def text(self):
+        return "\n".join(self.lines) + "\n"
+
+
+def emit_clear(w, msg, fields):
+    w("static void %s_clear_fast(%s *dest)" % (msg, msg))
+    w("{")
+    for f in fields:
+        if f.htype == "ARRAY":
+            w("dest->%s = 0;" % f.size_name, 1)
+            continue
+        w("dest->%s = false;" % f.size_name, 1)
+        if f.ltype == "SUBMESSAGE":
+            w("%s_clear_fast(&dest->%s);" % (f.submessage, f.name), 1)
+        elif f.ltype == "BYTES":
+            w("dest->%s.size = 0;" % f.name, 1)
+        elif f.default:
+            w("dest->%s = %s;" % (f.name, f.default), 1)
+        else:
+            w("dest->%s = 0;" % f.name, 1)
+    w("}")
+    w()
+
+
+def emit_scalar_read(w, f, target, stream, indent):
+    """Decode one scalar element of field f from stream into target."""
+    if f.ltype in ("VARINT", "SVARINT"):
+        w("if (!pb_decode_varint(%s, &value))" % stream, indent)
+        w("{", indent)
+        w("return false;", indent + 1)
+        w("}", indent)
+        if f.ltype == "VARINT":
+            w("%s = (%s) value;" % (target, f.ctype), indent)
+        else:
+            w("%s = (%s) pb_fast_unzigzag(value);" % (target, f.ctype), indent)
+    else:
+        decoder = "pb_dec_fixed32" if f.ltype == "FIXED32" else "pb_dec_fixed64"
+        w("if (!%s(%s, NULL, &%s))" % (decoder, stream, target), indent)
+        w("{", indent)
+        w("return false;", indent + 1)
+        w("}", indent)
+
+
+def emit_decode(w, msg, fields):
+    uses_value = any(f.ltype in ("VARINT", "SVARINT", "BYTES") for f in fields)
+    uses_substream = any(f.ltype == "SUBMESSAGE" or
+                         (f.htype == "ARRAY" and f.ltype in PACKABLE) for f in fields)
+
+    w("bool %s_decode_fast(pb_istream_t *stream, %s *dest)" % (msg, msg))
+    w("{")
+    w("uint64_t key;", 1)
+    if uses_value:
+        w("uint64_t value;", 1)
+    if uses_substream:
+        w("pb_istream_t substream;", 1)
+    w()
+    w("%s_clear_fast(dest);" % msg, 1)
+    w()
+    w("while (stream->bytes_left)", 1)
+    w("{", 1)
+    w("if (!pb_decode_varint(stream, &key))", 2)
+    w("{", 2)
+    w("return false;", 3)
+    w("}", 2)
+    w("if (key == 0)", 2)
+    w("{", 2)
+    w("/* Zero terminated message */", 3)
+    w("break;", 3)
+    w("}", 2)
+    w()
+    w("switch (key)", 2)
+    w("{", 2)
+
+    for f in fields:
+        w("case %s:" % key(f), 3)
+        if f.htype == "ARRAY":
+            w("if (dest->%s >= pb_arraysize(%s, %s))" % (f.size_name, msg, f.name), 4)
+            w("{", 4)
+            w("return false;", 5)
+            w("}", 4)
+            element = "dest->%s[dest->%s++]" % (f.name, f.size_name)
+        else:
+            w("dest->%s = true;" % f.size_name, 4)
+            element = "dest->%s" % f.name
+
+        if f.ltype == "SUBMESSAGE":
+            w("if (!pb_fast_open_substream(stream, &substream)", 4)
+            w("        || !%s_decode_fast(&substream, &%s))" % (f.submessage, element), 4)
+            w("{", 4)
+            w("return false;", 5)
+            w("}", 4)
+            w("stream->state = substream.state;", 4)
+        elif f.ltype == "BYTES":
+            w("if (!pb_decode_varint(stream, &value)", 4)
+            w("        || value > sizeof(%s.bytes))" % element, 4)
+            w("{", 4)
+            w("return false;", 5)
+            w("}", 4)
+            w("%s.size = (size_t) value;" % element, 4)
+            w("if (!pb_read(stream, %s.bytes, %s.size))" % (element, element), 4)
+            w("{", 4)
+            w("return false;", 5)
+            w("}", 4)
+        else:
+            emit_scalar_read(w, f, element, "stream", 4)
+        w("break;", 4)
+        w()
+
+        if f.htype == "ARRAY" and f.ltype in PACKABLE:
+            w("case %s:" % key(f, "PB_WT_STRING"), 3)
+            w("if (!pb_fast_open_substream(stream, &substream))", 4)
+            w("{", 4)
+            w("return false;", 5)
+            w("}", 4)
+            w("while (substream.bytes_left", 4)
+            w("        && dest->%s < pb_arraysize(%s, %s))" % (f.size_name, msg, f.name), 4)
+            w("{", 4)
+            emit_scalar_read(w, f, "dest->%s[dest->%s]" % (f.name, f.size_name),
+                             "&substream", 5)
+            w("dest->%s++;" % f.size_name, 5)
+            w("}", 4)
+            w("if (substream.bytes_left)", 4)
+            w("{", 4)
+            w("return false;", 5)
+            w("}", 4)
+            w("stream->state = substream.state;", 4)
+            w("break;", 4)
+            w()
+
+    w("default:", 3)
+    w("/* Known fields on any other wire type are left to pb_decode() */", 4)
+    w("switch (key >> 3)", 4)
+    w("{", 4)
+    for f in fields:
+        w("case %d:" % f.tag, 5)
+    w("return false;", 6)
+    w("default:", 5)
+    w("break;", 6)
+    w("}", 4)
+    w("if (!pb_skip_field(stream, (pb_wire_type_t) (key & 0x07)))", 4)
+    w("{", 4)
+    w("return false;", 5)
+    w("}", 4)
+    w("break;", 4)
+    w("}", 2)
+    w("}", 1)
+    w()
+    w("return true;", 1)
+    w("}")
+    w()
+
+
+def scalar_size_expr(f, expr):
+    if f.ltype == "VARINT":
+        return "pb_fast_varint_size(%s)" % varint_value(f, expr)
+    if f.ltype == "SVARINT":
+        return "pb_fast_varint_size(pb_fast_zigzag((int64_t) %s))" % expr
+    return "4" if f.ltype == "FIXED32" else "8"
+
+
+def emit_packed_payload(w, msg, f, indent):
+    """Compute the payload size of a packed array into 'payload'."""
+    if f.ltype in ("FIXED32", "FIXED64"):
+        w("payload = %s * src->%s;" % (scalar_size_expr(f, None), f.size_name), indent)
+        return
+    w("payload = 0;", indent)
+    w("for (i = 0; i < src->%s; i++)" % f.size_name, indent)
+    w("{", indent)
+    w("payload += %s;" % scalar_size_expr(f, "src->%s[i]" % f.name), indent + 1)
+    w("}", indent)
+
+
+def emit_size(w, msg, fields):
+    has_loop = any(f.htype == "ARRAY" and f.ltype not in ("FIXED32", "FIXED64")
+                   for f in fields)
+    has_payload = any(f.htype == "ARRAY" and f.ltype in PACKABLE or
+                      f.ltype == "SUBMESSAGE" for f in fields)
+
+    w("static size_t %s_size_fast(const %s *src)" % (msg, msg))
+    w("{")
+    w("size_t size = 0;", 1)
+    if has_payload:
+        w("size_t payload;", 1)
+    if has_loop:
+        w("size_t i;", 1)
+    w()
+    for f in fields:
+        if f.htype == "ARRAY" and f.ltype == "SUBMESSAGE":
+            w("for (i = 0; i < src->%s; i++)" % f.size_name, 1)
+            w("{", 1)
+            w("payload = %s_size_fast(&src->%s[i]);" % (f.submessage, f.name), 2)
+            w("size += %d + pb_fast_varint_size(payload) + payload;" % key_size(f), 2)
+            w("}", 1)
+        elif f.htype == "ARRAY":
+            w("if (src->%s)" % f.size_name, 1)
+            w("{", 1)
+            emit_packed_payload(w, msg, f, 2)
+            w("size += %d + pb_fast_varint_size(payload) + payload;"
+              % key_size(f, "PB_WT_STRING"), 2)
+            w("}", 1)
+        else:
+            w("if (src->%s)" % f.size_name, 1)
+            w("{", 1)
+            if f.ltype == "SUBMESSAGE":
+                w("payload = %s_size_fast(&src->%s);" % (f.submessage, f.name), 2)
+                w("size += %d + pb_fast_varint_size(payload) + payload;" % key_size(f), 2)
+            elif f.ltype == "BYTES":
+                w("size += %d + pb_fast_varint_size(src->%s.size) + src->%s.size;"
+                  % (key_size(f), f.name, f.name), 2)
+            else:
+                w("size += %d + %s;" % (key_size(f), scalar_size_expr(f, "src->%s" % f.name)), 2)
+            w("}", 1)
+    w()
+    w("return size;", 1)
+    w("}")
+    w()
+
+
+def emit_scalar_write(w, f, expr, indent):
+    if f.ltype == "VARINT":
+        call = "pb_encode_varint(stream, %s)" % varint_value(f, expr)
+    elif f.ltype == "SVARINT":
+        call = "pb_encode_svarint(stream, (int64_t) %s)" % expr
+    elif f.ltype == "FIXED32":
+        call = "pb_encode_fixed32(stream, &%s)" % expr
+    else:
+        call = "pb_encode_fixed64(stream, &%s)" % expr
+    return call
+
+
+def emit_encode(w, msg, fields):
+    has_loop = any(f.htype == "ARRAY" for f in fields)
+    has_payload = any(f.htype == "ARRAY" and f.ltype in PACKABLE for f in fields)
+
+    w("bool %s_encode_fast(pb_ostream_t *stream, const %s *src)" % (msg, msg))
+    w("{")
+    if has_payload:
+        w("size_t payload;", 1)
+    if has_loop:
+        w("size_t i;", 1)
+    if has_loop or has_payload:
+        w()
+    for f in fields:
+        if f.htype == "ARRAY" and f.ltype == "SUBMESSAGE":
+            w("for (i = 0; i < src->%s; i++)" % f.size_name, 1)
+            w("{", 1)
+            w("if (!pb_encode_varint(stream, %s)" % key(f), 2)
+            w("        || !pb_encode_varint(stream, %s_size_fast(&src->%s[i]))"
+              % (f.submessage, f.name), 2)
+            w("        || !%s_encode_fast(stream, &src->%s[i]))" % (f.submessage, f.name), 2)
+            w("{", 2)
+            w("return false;", 3)
+            w("}", 2)
+            w("}", 1)
+        elif f.htype == "ARRAY":
+            w("if (src->%s)" % f.size_name, 1)
+            w("{", 1)
+            emit_packed_payload(w, msg, f, 2)
+            w("if (!pb_encode_varint(stream, %s)" % key(f, "PB_WT_STRING"), 2)
+            w("        || !pb_encode_varint(stream, payload))", 2)
+            w("{", 2)
+            w("return false;", 3)
+            w("}", 2)
+            w("for (i = 0; i < src->%s; i++)" % f.size_name, 2)
+            w("{", 2)
+            w("if (!%s)" % emit_scalar_write(w, f, "src->%s[i]" % f.name, 3), 3)
+            w("{", 3)
+            w("return false;", 4)
+            w("}", 3)
+            w("}", 2)
+            w("}", 1)
+        else:
+            w("if (src->%s)" % f.size_name, 1)
+            w("{", 1)
+            w("if (!pb_encode_varint(stream, %s)" % key(f), 2)
+            if f.ltype == "SUBMESSAGE":
+                w("        || !pb_encode_varint(stream, %s_size_fast(&src->%s))"
+                  % (f.submessage, f.name), 2)
+                w("        || !%s_encode_fast(stream, &src->%s))" % (f.submessage, f.name), 2)
+            elif f.ltype == "BYTES":
+                w("        || src->%s.size > sizeof(src->%s.bytes)" % (f.name, f.name), 2)
+                w("        || !pb_encode_string(stream, src->%s.bytes, src->%s.size))"
+                  % (f.name, f.name), 2)
+            else:
+                w("        || !%s)" % emit_scalar_write(w, f, "src->%s" % f.name, 2), 2)
+            w("{", 2)
+            w("return false;", 3)
+            w("}", 2)
+            w("}", 1)
+    w()
+    w("return true;", 1)
+    w("}")
+    w()
+
+
+def closure(tables, roots):
+    """Return roots and their submessages, submessages first."""
+    order = []
+
+    def visit(name):
+        if name in order:
+            return
+        if name not in tables:
+            sys.exit("unknown message %s" % name)
+        for f in tables[name]:
+            if f.submessage:
+                visit(f.submessage)
+        order.append(name)
+
+    for name in roots:
+        visit(name)
+    return order
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("header", help="nanopb generated messages.pb.h")
+    parser.add_argument("source", help="nanopb generated messages.pb.c")
+    parser.add_argument("-o", "--output", required=True,
+                        help="output path without extension")
+    parser.add_argument("--decode", default=",".join(DEFAULT_DECODE),
+                        help="comma separated messages to generate decoders for")
+    parser.add_argument("--encode", default=",".join(DEFAULT_ENCODE),
+                        help="comma separated messages to generate encoders for")
+    args = parser.parse_args()
+
+    with open(args.header, newline="") as f:
+        header = f.read().replace("\r\n", "\n")
+    with open(args.source, newline="") as f:
+        source = f.read().replace("\r\n", "\n")
+
+    structs = parse_structs(header)
+    tables = parse_tables(source)
+    for name, fields in tables.items():
+        for f in fields:
+            f.ctype = structs[name][f.name]
+
+    decode_roots = [m for m in args.decode.split(",") if m]
+    encode_roots = [m for m in args.encode.split(",") if m]
+    decode = closure(tables, decode_roots)
+    encode = closure(tables, encode_roots)
+
+    base = os.path.basename(args.output)
+    guard = "_PB_%s_PB_H_" % base.upper()
+    banner = "/* Automatically generated by tools/pb_fastgen.py from %s, do not edit */" % \
+        os.path.basename(args.source)
+
+    h = Writer()
+    h(banner)
+    h("#ifndef %s" % guard)
+    h("#define %s" % guard)
+    h("#include <pb_decode.h>")
+    h("#include <pb_encode.h>")
+    h('#include "%s"' % os.path.basename(args.header))
+    h()
+    h("/* Type erased codec for a message field table */")
+    h("typedef bool (*pb_fast_decoder_t)(pb_istream_t *stream, void *dest);")
+    h("typedef bool (*pb_fast_encoder_t)(pb_ostream_t *stream, const void *src);")
+    h()
+    h("typedef struct")
+    h("{")
+    h("const pb_field_t  *fields;", 1)
+    h("pb_fast_decoder_t  decode;", 1)
+    h("pb_fast_encoder_t  encode;", 1)
+    h("} pb_fast_codec_t;")
+    h()
+    h("/* Specialised decoders. Return false where pb_decode() should be used instead. */")
+    for msg in decode:
+        h("bool %s_decode_fast(pb_istream_t *stream, %s *dest);" % (msg, msg))
+    h()
+    h("/* Specialised encoders */")
+    for msg in encode:
+        h("bool %s_encode_fast(pb_ostream_t *stream, const %s *src);" % (msg, msg))
+    h()
+    h("/* Returns the codec for a message field table, or NULL if there is none */")
+    h("const pb_fast_codec_t* pb_fast_find_codec(const pb_field_t fields[]);")
+    h()
+    h("#endif")
+
+    c = Writer()
+    c(banner)
+    c('#include "%s.h"' % base)
+    c()
+    if decode:
+        c("static int64_t pb_fast_unzigzag(uint64_t value)")
+        c("{")
+        c("return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);", 1)
+        c("}")
+        c()
+        c("static bool pb_fast_open_substream(pb_istream_t *stream, pb_istream_t *substream)")
+        c("{")
+        c("uint64_t size;", 1)
+        c()
+        c("if (!pb_decode_varint(stream, &size) || size > stream->bytes_left)", 1)
+        c("{", 1)
+        c("return false;", 2)
+        c("}", 1)
+        c()
+        c("*substream = *stream;", 1)
+        c("substream->bytes_left = (size_t) size;", 1)
+        c("stream->bytes_left -= (size_t) size;", 1)
+        c("return true;", 1)
+        c("}")
+        c()
+    if any(f.ltype == "SVARINT" for msg in encode for f in tables[msg]):
+        c("static uint64_t pb_fast_zigzag(int64_t value)")
+        c("{")
+        c("return (value < 0) ? ~((uint64_t) value << 1) : ((uint64_t) value << 1);", 1)
+        c("}")
+        c()
+    if encode:
+        c("static size_t pb_fast_varint_size(uint64_t value)")
+        c("{")
+        c("size_t size = 1;", 1)
+        c()
+        c("while (value > 0x7F)", 1)
+        c("{", 1)
+        c("value >>= 7;", 2)
+        c("size++;", 2)
+        c("}", 1)
+        c("return size;", 1)
+        c("}")
+        c()
+    for msg in decode:
+        emit_clear(c, msg, tables[msg])
+        emit_decode(c, msg, tables[msg])
+    # Only submessages need their encoded size up front
+    sized = set(f.submessage for msg in encode for f in tables[msg] if f.submessage)
+    for msg in encode:
+        if msg in sized:
+            emit_size(c, msg, tables[msg])
+        emit_encode(c, msg, tables[msg])
+
+    roots = []
+    for msg in decode_roots + encode_roots:
+        if msg not in roots:
+            roots.append(msg)
+    for msg in roots:
+        if msg in decode_roots:
+            c("static bool %s_decode_erased(pb_istream_t *stream, void *dest)" % msg)
+            c("{")
+            c("return %s_decode_fast(stream, (%s*) dest);" % (msg, msg), 1)
+            c("}")
+            c()
+        if msg in encode_roots:
+            c("static bool %s_encode_erased(pb_ostream_t *stream, const void *src)" % msg)
+            c("{")
+            c("return %s_encode_fast(stream, (const %s*) src);" % (msg, msg), 1)
+            c("}")
+            c()
+
+    c("static const pb_fast_codec_t pb_fast_codecs[] =")
+    c("{")
+    for msg in roots:
+        dec = "%s_decode_erased" % msg if msg in decode_roots else "NULL"
+        enc = "%s_encode_erased" % msg if msg in encode_roots else "NULL"
+        c("{ %s_fields, %s, %s }," % (msg, dec, enc), 1)
+    c("};")
+    c()
+    c("const pb_fast_codec_t* pb_fast_find_codec(const pb_field_t fields[])")
+    c("{")
+    c("size_t i;", 1)
+    c()
+    c("for (i = 0; i < sizeof(pb_fast_codecs) / sizeof(pb_fast_codecs[0]); i++)", 1)
+    c("{", 1)
+    c("if (pb_fast_codecs[i].fields == fields)", 2)
+    c("{", 2)
+    c("return &pb_fast_codecs[i];", 3)
+    c("}", 2)
+    c("}", 1)
+    c("return NULL;", 1)
+    c("}")
+
+    for path, writer in ((args.output + ".h", h), (args.output + ".c", c)):
+        # PbMessages sources use CRLF line endings
+        with open(path, "w", newline="\r\n") as f:
+            f.write(writer.text())
+
+
+if __name__ == "__main__":
+    main()